@@ -29,6 +29,9 @@ cd ..
 
 echo.
 echo Build complete! Files generated in wasm-build/
+echo   chess.js          page main thread
+echo   chess-worker.mjs  Web Worker / Node.js
+echo   chess-mt.mjs      Web Worker / Node.js with threads (needs SharedArrayBuffer)
 echo.
 echo To test, run:
 echo   serve.bat
@@ -18,6 +18,9 @@ emmake make -j$(nproc 2>/dev/null || echo 4)
 
 echo ""
 echo "Build complete! Files generated in wasm-build/"
+echo "  chess.js          page main thread"
+echo "  chess-worker.mjs  Web Worker / Node.js"
+echo "  chess-mt.mjs      Web Worker / Node.js with threads (needs SharedArrayBuffer)"
 echo ""
 echo "To test, run:"
 echo "  cd web"
@@ -1,267 +1,608 @@
 #include "AI.h"
+#include "MovePicker.h"
+#include "PieceSquareTables.h"
 #include <algorithm>
 #include <random>
+#include <sstream>
 #include <chrono>
+#include <thread>
 
-// Piece-Square Tables (from white's perspective, will be mirrored for black)
-// Values encourage good piece placement
-
-const int AI::pawnTable[8][8] = {
-    {  0,   0,   0,   0,   0,   0,   0,   0},
-    { 50,  50,  50,  50,  50,  50,  50,  50},
-    { 10,  10,  20,  30,  30,  20,  10,  10},
-    {  5,   5,  10,  25,  25,  10,   5,   5},
-    {  0,   0,   0,  20,  20,   0,   0,   0},
-    {  5,  -5, -10,   0,   0, -10,  -5,   5},
-    {  5,  10,  10, -20, -20,  10,  10,   5},
-    {  0,   0,   0,   0,   0,   0,   0,   0}
-};
-
-const int AI::knightTable[8][8] = {
-    {-50, -40, -30, -30, -30, -30, -40, -50},
-    {-40, -20,   0,   0,   0,   0, -20, -40},
-    {-30,   0,  10,  15,  15,  10,   0, -30},
-    {-30,   5,  15,  20,  20,  15,   5, -30},
-    {-30,   0,  15,  20,  20,  15,   0, -30},
-    {-30,   5,  10,  15,  15,  10,   5, -30},
-    {-40, -20,   0,   5,   5,   0, -20, -40},
-    {-50, -40, -30, -30, -30, -30, -40, -50}
-};
-
-const int AI::bishopTable[8][8] = {
-    {-20, -10, -10, -10, -10, -10, -10, -20},
-    {-10,   0,   0,   0,   0,   0,   0, -10},
-    {-10,   0,   5,  10,  10,   5,   0, -10},
-    {-10,   5,   5,  10,  10,   5,   5, -10},
-    {-10,   0,  10,  10,  10,  10,   0, -10},
-    {-10,  10,  10,  10,  10,  10,  10, -10},
-    {-10,   5,   0,   0,   0,   0,   5, -10},
-    {-20, -10, -10, -10, -10, -10, -10, -20}
-};
-
-const int AI::rookTable[8][8] = {
-    {  0,   0,   0,   0,   0,   0,   0,   0},
-    {  5,  10,  10,  10,  10,  10,  10,   5},
-    { -5,   0,   0,   0,   0,   0,   0,  -5},
-    { -5,   0,   0,   0,   0,   0,   0,  -5},
-    { -5,   0,   0,   0,   0,   0,   0,  -5},
-    { -5,   0,   0,   0,   0,   0,   0,  -5},
-    { -5,   0,   0,   0,   0,   0,   0,  -5},
-    {  0,   0,   0,   5,   5,   0,   0,   0}
-};
-
-const int AI::queenTable[8][8] = {
-    {-20, -10, -10,  -5,  -5, -10, -10, -20},
-    {-10,   0,   0,   0,   0,   0,   0, -10},
-    {-10,   0,   5,   5,   5,   5,   0, -10},
-    { -5,   0,   5,   5,   5,   5,   0,  -5},
-    {  0,   0,   5,   5,   5,   5,   0,  -5},
-    {-10,   5,   5,   5,   5,   5,   0, -10},
-    {-10,   0,   5,   0,   0,   0,   0, -10},
-    {-20, -10, -10,  -5,  -5, -10, -10, -20}
-};
-
-const int AI::kingMiddleGameTable[8][8] = {
-    {-30, -40, -40, -50, -50, -40, -40, -30},
-    {-30, -40, -40, -50, -50, -40, -40, -30},
-    {-30, -40, -40, -50, -50, -40, -40, -30},
-    {-30, -40, -40, -50, -50, -40, -40, -30},
-    {-20, -30, -30, -40, -40, -30, -30, -20},
-    {-10, -20, -20, -20, -20, -20, -20, -10},
-    { 20,  20,   0,   0,   0,   0,  20,  20},
-    { 20,  30,  10,   0,   0,  10,  30,  20}
-};
-
-const int AI::kingEndGameTable[8][8] = {
-    {-50, -40, -30, -20, -20, -30, -40, -50},
-    {-30, -20, -10,   0,   0, -10, -20, -30},
-    {-30, -10,  20,  30,  30,  20, -10, -30},
-    {-30, -10,  30,  40,  40,  30, -10, -30},
-    {-30, -10,  30,  40,  40,  30, -10, -30},
-    {-30, -10,  20,  30,  30,  20, -10, -30},
-    {-30, -30,   0,   0,   0,   0, -30, -30},
-    {-50, -30, -30, -30, -30, -30, -30, -50}
-};
-
-AI::AI(Color color, int depth) : aiColor(color), maxDepth(depth) {}
-
-bool AI::isEndGame(const Board& board) const {
-    int totalMaterial = 0;
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* p = board.getPiece(r, c);
-            if (p && p->getType() != PieceType::King && p->getType() != PieceType::Pawn) {
-                totalMaterial += p->getValue();
-            }
-        }
-    }
-    return totalMaterial < 2600; // Queens and a few pieces
+AI::AI(Color color, int depth)
+    : maxDepth(depth), aiColor(color), timeLimitMs(0), threadId(0),
+      randomMargin(0), nodes(0), completedDepth(0), aborted(false),
+      tt(std::make_shared<TranspositionTable>()) {
+    setRandomSeed(std::random_device()());
 }
 
-int AI::getPieceSquareValue(const Piece* piece, bool endGame) const {
-    if (!piece) return 0;
+AI::AI(Color color, std::shared_ptr<TranspositionTable> table, int id)
+    : maxDepth(0), aiColor(color), timeLimitMs(0), threadId(id),
+      randomMargin(0), randomSeed(0), nodes(0), completedDepth(0), aborted(false),
+      tt(std::move(table)) {}
 
-    int row = piece->getRow();
-    int col = piece->getCol();
+void AI::setColor(Color color) {
+    aiColor = color;
+    for (auto& helper : helpers) {
+        helper->aiColor = color;
+    }
+}
 
-    // Mirror for black pieces
-    if (piece->getColor() == Color::Black) {
-        row = 7 - row;
+void AI::setThreads(int threads) {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    threads = 1;  // Built without pthread support
+#elif defined(CHESS_THREAD_POOL_SIZE)
+    threads = std::min(threads, CHESS_THREAD_POOL_SIZE + 1);  // Helpers come from a fixed pool
+#endif
+    helpers.clear();
+    for (int id = 1; id < threads; ++id) {
+        helpers.emplace_back(new AI(aiColor, tt, id));
+        helpers.back()->options = options;
     }
+}
 
-    switch (piece->getType()) {
-        case PieceType::Pawn:   return pawnTable[row][col];
-        case PieceType::Knight: return knightTable[row][col];
-        case PieceType::Bishop: return bishopTable[row][col];
-        case PieceType::Rook:   return rookTable[row][col];
-        case PieceType::Queen:  return queenTable[row][col];
-        case PieceType::King:
-            return endGame ? kingEndGameTable[row][col] : kingMiddleGameTable[row][col];
-        default: return 0;
+void AI::setSearchOptions(const SearchOptions& searchOptions) {
+    options = searchOptions;
+    for (auto& helper : helpers) {
+        helper->options = searchOptions;
     }
 }
 
 int AI::evaluate(const Board& board) const {
-    int score = 0;
-    bool endGame = isEndGame(board);
+    // Board keeps material and piece-square sums for the middlegame and the
+    // endgame; blend them by how much material is left
+    Color us = board.getCurrentTurn();
+    Color them = Piece::oppositeColor(us);
+    int phase = std::min(board.getPhase(), PieceSquare::MaxPhase);
+    int midgame = board.getMidgameScore(us) - board.getMidgameScore(them);
+    int endgame = board.getEndgameScore(us) - board.getEndgameScore(them);
+    return (midgame * phase + endgame * (PieceSquare::MaxPhase - phase)) / PieceSquare::MaxPhase;
+}
 
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* piece = board.getPiece(r, c);
-            if (!piece) continue;
+void AI::orderMoves(MoveList& moves, const Board& board) const {
+    // Score every move once: captures by MVV-LVA (most valuable victim,
+    // then least valuable attacker) and promotions ahead of quiet moves,
+    // which are ordered by history
+    static constexpr int CaptureScore = 1 << 20;
+
+    int scores[MoveList::Capacity];
+    Color us = board.getCurrentTurn();
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        int score = 0;
+        if (move.isCapture()) {
+            PieceType victim = (move.type() == MoveType::EnPassant)
+                                   ? PieceType::Pawn
+                                   : board.getPieceTypeAt(move.to());
+            score = CaptureScore + Piece::pieceValue(victim) * 10 -
+                    Piece::pieceValue(board.getPieceTypeAt(move.from()));
+        }
+        if (move.isPromotion()) {
+            score += CaptureScore + Piece::pieceValue(move.promotionPiece());
+        }
+        if (score == 0) {
+            score = history.score(us, move);
+        }
+        scores[i] = score;
+    }
 
-            int pieceValue = piece->getValue() + getPieceSquareValue(piece, endGame);
+    // Selection sort on the precomputed scores (the root list is short)
+    for (size_t i = 0; i + 1 < moves.size(); ++i) {
+        size_t best = i;
+        for (size_t j = i + 1; j < moves.size(); ++j) {
+            if (scores[j] > scores[best]) best = j;
+        }
+        std::swap(moves[i], moves[best]);
+        std::swap(scores[i], scores[best]);
+    }
+}
 
-            if (piece->getColor() == aiColor) {
-                score += pieceValue;
-            } else {
-                score -= pieceValue;
+void AI::storeKiller(int ply, const Move& move) {
+    if (ply >= MaxPly || move.isCapture() || move.isPromotion()) return;
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+}
+
+int AI::elapsedMs() const {
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+}
+
+bool AI::shouldStop() {
+    if (aborted) return true;
+    if (completedDepth == 0 && threadId == 0) return false;  // Always finish the first iteration
+
+    if ((limits.nodes && nodes >= limits.nodes) ||
+        (limits.stop && limits.stop->load(std::memory_order_relaxed)) ||
+        (limits.hardTimeMs > 0 && (nodes & 1023) == 0 && elapsedMs() >= limits.hardTimeMs)) {
+        aborted = true;
+    }
+    return aborted;
+}
+
+int AI::quiescence(Board& board, int ply, int alpha, int beta) {
+    // Margin for positional swings when pruning captures by material alone
+    static constexpr int DeltaMargin = 200;
+
+    ++nodes;
+    ++stats.qnodes;
+    stats.seldepth = std::max(stats.seldepth, ply);
+    if (shouldStop()) return 0;
+
+    Color us = board.getCurrentTurn();
+    bool inCheck = board.isInCheck(us);
+
+    // Stand pat: the side to move may decline every capture. Not available
+    // in check, where every evasion is searched and none means mate.
+    int standPat = 0;
+    int bestScore;
+    if (inCheck) {
+        bestScore = -MateScore + ply;
+    } else {
+        standPat = evaluate(board);
+        if (standPat >= beta) return standPat;
+        alpha = std::max(alpha, standPat);
+        bestScore = standPat;
+    }
+
+    MovePicker picker(board, us, inCheck);
+    Move move;
+    while (picker.next(move)) {
+        // Delta pruning: skip captures that cannot reach alpha even if the
+        // captured piece comes for free
+        if (!inCheck && !move.isPromotion()) {
+            PieceType victim = (move.type() == MoveType::EnPassant)
+                ? PieceType::Pawn : board.getPieceTypeAt(move.to());
+            if (standPat + Piece::pieceValue(victim) + DeltaMargin <= alpha) continue;
+        }
+
+        UndoInfo undo;
+        board.makeMove(move, undo);
+        int score = -quiescence(board, ply + 1, -beta, -alpha);
+        board.undoMove(move, undo);
+        if (aborted) return 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) break;
             }
         }
     }
 
-    return score;
+    return bestScore;
 }
 
-void AI::orderMoves(std::vector<Move>& moves, Board& board) {
-    // Simple move ordering: captures first, then others
-    std::sort(moves.begin(), moves.end(), [&board](const Move& a, const Move& b) {
-        int scoreA = 0, scoreB = 0;
-
-        // Prioritize captures
-        if (a.isCapture()) {
-            Piece* captured = board.getPiece(a.toRow, a.toCol);
-            Piece* attacker = board.getPiece(a.fromRow, a.fromCol);
-            if (captured && attacker) {
-                // MVV-LVA (Most Valuable Victim - Least Valuable Attacker)
-                scoreA = captured->getValue() * 10 - attacker->getValue();
+int AI::search(Board& board, int depth, int ply, int alpha, int beta, bool allowNull) {
+    // Pruning margins in centipawns, indexed by remaining depth
+    static constexpr int RazorMargin[3] = {0, 300, 550};
+    static constexpr int FutilityMargin[3] = {0, 200, 450};
+
+    ++nodes;
+    stats.seldepth = std::max(stats.seldepth, ply);
+    if (shouldStop()) return 0;
+
+    Color us = board.getCurrentTurn();
+    bool pvNode = beta - alpha > 1;
+
+    // Transposition table: reuse the result of an earlier search of this
+    // position if it was deep enough, otherwise take its best move first.
+    // PV nodes search on so the principal variation is not cut short.
+    uint64_t key = board.getHashKey();
+    Move hashMove;
+    TTEntry entry;
+    if (depth > 0) ++stats.hashProbes;
+    if (depth > 0 && tt->probe(key, entry)) {
+        ++stats.hashHits;
+        hashMove = entry.move;
+        if (!pvNode && entry.depth >= depth) {
+            int score = TranspositionTable::scoreFromTT(entry.score, ply);
+            if (entry.bound == Bound::Exact ||
+                (entry.bound == Bound::Lower && score >= beta) ||
+                (entry.bound == Bound::Upper && score <= alpha)) {
+                return score;
             }
         }
+    }
+
+    // Checkmate and stalemate show up as a node without legal moves below;
+    // leaves go straight to quiescence without generating anything here
+    if (board.isDraw()) {
+        return 0;
+    }
+    if (depth == 0) {
+        return quiescence(board, ply, alpha, beta);
+    }
+
+    bool inCheck = board.isInCheck(us);
+    bool selective = !pvNode && !inCheck;
+    int staticEval = selective ? evaluate(board) : 0;
+
+    // Razoring: far below alpha near the leaves, only a capture can help
+    if (options.razoring && selective && depth <= 2 &&
+        staticEval + RazorMargin[depth] <= alpha) {
+        int score = quiescence(board, ply, alpha, alpha + 1);
+        if (aborted) return 0;
+        if (score <= alpha) return score;
+    }
+
+    // Null move pruning: if passing still holds beta, a real move will too.
+    // Not in pawn endings, where having to move (zugzwang) is common.
+    if (options.nullMove && selective && allowNull && depth >= 3 &&
+        staticEval >= beta && board.hasNonPawnMaterial(us)) {
+        int reduction = (depth >= 6) ? 3 : 2;
+        UndoInfo undo;
+        board.makeNullMove(undo);
+        int score = -search(board, depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+        board.undoNullMove(undo);
+        if (aborted) return 0;
+        if (score >= beta) {
+            return (score >= MateBound) ? beta : score;  // Unproven mates are not trusted
+        }
+    }
+
+    // Futility pruning: near the leaves, quiet moves cannot lift a hopeless
+    // static evaluation to alpha
+    bool futile = options.futilityPruning && selective && depth <= 2 &&
+                  staticEval + FutilityMargin[depth] <= alpha;
+
+    // Principal variation search: the first move gets the full window, the
+    // rest only a null window to prove they are no better, and are searched
+    // again in full if that proof fails
+    const Move* plyKillers = ply < MaxPly ? killers[ply] : nullptr;
+    MovePicker picker(board, us, hashMove, plyKillers, plyKillers ? 2 : 0, &history);
+    Move move;
+    Move bestMove;
+    int originalAlpha = alpha;
+    int bestScore = -Infinity;
+    int moveCount = 0;
+
+    // Quiet moves searched without a cutoff, penalized in the history
+    // when a later quiet move cuts off
+    Move quietsTried[64];
+    int quietCount = 0;
+
+    while (picker.next(move)) {
+        bool quiet = !move.isCapture() && !move.isPromotion();
+        bool killer = plyKillers && (move == plyKillers[0] || move == plyKillers[1]);
+        bool checks = quiet && board.givesCheck(move);
+
+        if (futile && quiet && moveCount > 0 && !checks) {
+            continue;
+        }
 
-        if (b.isCapture()) {
-            Piece* captured = board.getPiece(b.toRow, b.toCol);
-            Piece* attacker = board.getPiece(b.fromRow, b.fromCol);
-            if (captured && attacker) {
-                scoreB = captured->getValue() * 10 - attacker->getValue();
+        UndoInfo undo;
+        board.makeMove(move, undo);
+        int score;
+        if (moveCount++ == 0) {
+            score = -search(board, depth - 1, ply + 1, -beta, -alpha);
+        } else {
+            // Late move reductions: quiet moves ordered late rarely matter,
+            // so search them shallower first and verify any that beat alpha
+            int reduction = 0;
+            if (options.lateMoveReductions && depth >= 3 && moveCount > 4 &&
+                quiet && !killer && !checks && !inCheck) {
+                reduction = (moveCount > 10 && depth >= 6) ? 2 : 1;
+            }
+
+            score = -search(board, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (reduction > 0 && score > alpha) {
+                score = -search(board, depth - 1, ply + 1, -alpha - 1, -alpha);
+            }
+            if (score > alpha && score < beta) {
+                score = -search(board, depth - 1, ply + 1, -beta, -alpha);
             }
         }
+        board.undoMove(move, undo);
+        if (aborted) return 0;
 
-        // Prioritize promotions
-        if (a.isPromotion()) scoreA += 800;
-        if (b.isPromotion()) scoreB += 800;
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    ++stats.betaCutoffs;
+                    if (moveCount == 1) ++stats.firstMoveCutoffs;
+                    if (quiet) {
+                        storeKiller(ply, move);
+                        history.update(us, move, board.getLastMove(), quietsTried, quietCount,
+                                       depth);
+                    }
+                    break;
+                }
+            }
+        }
+        if (quiet && quietCount < 64) {
+            quietsTried[quietCount++] = move;
+        }
+    }
 
-        return scoreA > scoreB;
-    });
+    // No legal moves: checkmate or stalemate. Futility pruning never skips
+    // the first move, so moves were not just pruned away.
+    if (moveCount == 0) {
+        bestScore = inCheck ? -MateScore + ply : 0;
+    }
+
+    Bound bound = Bound::Exact;
+    if (bestScore <= originalAlpha) {
+        bound = Bound::Upper;
+    } else if (bestScore >= beta) {
+        bound = Bound::Lower;
+    }
+    tt->store(key, depth, bound, TranspositionTable::scoreToTT(bestScore, ply), bestMove);
+
+    return bestScore;
 }
 
-int AI::minimax(Board& board, int depth, int alpha, int beta, bool maximizing) {
-    Color currentColor = maximizing ? aiColor : Piece::oppositeColor(aiColor);
+int AI::searchRoot(Board& board, std::vector<RootMove>& rootMoves, int depth, int alpha,
+                   int beta) {
+    // Moves that fail low against (best - margin - 1) are worse than the
+    // best move by more than the margin, so every score within the margin
+    // of the best one is exact
+    int bestScore = -Infinity;
 
-    // Terminal conditions
-    if (board.isCheckmate(currentColor)) {
-        return maximizing ? -100000 + (maxDepth - depth) : 100000 - (maxDepth - depth);
+    for (RootMove& rootMove : rootMoves) {
+        rootMove.score = -Infinity;
     }
-    if (board.isStalemate(currentColor) || board.isDraw()) {
-        return 0;
+
+    for (size_t i = 0; i < rootMoves.size(); ++i) {
+        const Move& move = rootMoves[i].move;
+        UndoInfo undo;
+        board.makeMove(move, undo);
+        int score;
+        if (i == 0) {
+            score = -search(board, depth - 1, 1, -beta, -alpha);
+        } else {
+            int floor = std::max(alpha, bestScore - randomMargin - 1);
+            score = -search(board, depth - 1, 1, -floor - 1, -floor);
+            if (score > floor && score < beta) {
+                score = -search(board, depth - 1, 1, -beta, -floor);
+            }
+        }
+        board.undoMove(move, undo);
+        if (aborted) return 0;
+
+        rootMoves[i].score = score;
+        if (score > bestScore) {
+            bestScore = score;
+            if (score >= beta) break;  // Fail high: the window is re-opened
+        }
     }
-    if (depth == 0) {
-        return evaluate(board);
+
+    // Best first, for the next iteration and the caller
+    std::stable_sort(rootMoves.begin(), rootMoves.end(),
+                     [](const RootMove& a, const RootMove& b) { return a.score > b.score; });
+    return bestScore;
+}
+
+Move AI::getBestMove(Board& board) {
+    return getBestMove(board, getSearchLimits());
+}
+
+SearchLimits AI::getSearchLimits() const {
+    SearchLimits searchLimits;
+    searchLimits.depth = maxDepth;
+    searchLimits.softTimeMs = timeLimitMs / 2;
+    searchLimits.hardTimeMs = timeLimitMs;
+    return searchLimits;
+}
+
+void AI::resetSearch(const SearchLimits& searchLimits) {
+    limits = searchLimits;
+    startTime = std::chrono::steady_clock::now();
+    nodes = 0;
+    completedDepth = 0;
+    aborted = false;
+    stats = SearchStats();
+
+    for (auto& plyKillers : killers) {
+        plyKillers[0] = plyKillers[1] = Move();
     }
+    history.age();
+}
 
-    auto moves = board.getLegalMoves(currentColor);
-    orderMoves(moves, board);
+Move AI::iterativeDeepening(Board& board, std::vector<RootMove>& rootMoves, int firstDepth,
+                            MoveList& candidates) {
+    // Aspiration window half-width around the previous iteration's score
+    static constexpr int AspirationWindow = 50;
+
+    int depthLimit = (limits.depth > 0) ? std::min(limits.depth, MaxPly - 1) : MaxPly - 1;
+    Move bestMove = rootMoves[0].move;
+    int previousScore = 0;
+
+    // Iterative deepening: each iteration orders the root by the previous
+    // one, and a search cut short by the limits is thrown away
+    for (int depth = firstDepth; depth <= depthLimit; ++depth) {
+        // Aspiration windows: expect a score close to the last one and
+        // widen the window on whichever side the result falls outside. The
+        // lower side leaves room for the randomization margin.
+        int delta = AspirationWindow;
+        int alpha = -Infinity;
+        int beta = Infinity;
+        if (depth >= 4) {
+            alpha = std::max(previousScore - delta - randomMargin, -Infinity);
+            beta = std::min(previousScore + delta, Infinity);
+        }
+
+        int bestScore;
+        while (true) {
+            bestScore = searchRoot(board, rootMoves, depth, alpha, beta);
+            if (aborted) break;
 
-    if (maximizing) {
-        int maxEval = std::numeric_limits<int>::min();
-        for (const auto& move : moves) {
-            Board newBoard(board);
-            newBoard.makeMove(move);
-            int eval = minimax(newBoard, depth - 1, alpha, beta, false);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha) break;
+            if (bestScore <= alpha) {
+                alpha = std::max(bestScore - delta - randomMargin, -Infinity);
+            } else if (bestScore >= beta) {
+                beta = std::min(bestScore + delta, Infinity);
+            } else {
+                break;
+            }
+            delta *= 2;
         }
-        return maxEval;
-    } else {
-        int minEval = std::numeric_limits<int>::max();
-        for (const auto& move : moves) {
-            Board newBoard(board);
-            newBoard.makeMove(move);
-            int eval = minimax(newBoard, depth - 1, alpha, beta, true);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-            if (beta <= alpha) break;
+        if (aborted) break;
+
+        completedDepth = depth;
+        previousScore = bestScore;
+        bestMove = rootMoves[0].move;
+        stats.score = bestScore;
+        stats.iterations.push_back({depth, bestScore, nodes, elapsedMs()});
+        tt->store(board.getHashKey(), depth, Bound::Exact,
+                  TranspositionTable::scoreToTT(bestScore, 0), bestMove);
+        if (threadId == 0 && iterationCallback) {
+            reportIteration(board, bestMove);
         }
-        return minEval;
+
+        // Scores at or below alpha are only bounds and do not qualify
+        candidates.clear();
+        for (const RootMove& rootMove : rootMoves) {
+            if (rootMove.score >= bestScore - randomMargin && rootMove.score > alpha) {
+                candidates.push_back(rootMove.move);
+            }
+        }
+
+        // A forced mate does not change with more depth
+        if (bestScore >= MateBound || bestScore <= -MateBound) break;
+        if (limits.softTimeMs > 0 && elapsedMs() >= limits.softTimeMs) break;
     }
+
+    return bestMove;
 }
 
-Move AI::getBestMove(Board& board) {
-    auto moves = board.getLegalMoves(aiColor);
+Move AI::getBestMove(Board& board, const SearchLimits& searchLimits) {
+    resetSearch(searchLimits);
+
+    // The search follows the board's side to move
+    Color savedTurn = board.getCurrentTurn();
+    board.setCurrentTurn(aiColor);
+
+    MoveList moves;
+    board.getLegalMoves(aiColor, moves);
 
     if (moves.empty()) {
+        board.setCurrentTurn(savedTurn);
         return Move(); // No valid moves
     }
 
     orderMoves(moves, board);
 
-    Move bestMove = moves[0];
-    int bestScore = std::numeric_limits<int>::min();
+    // Search the previous best move for this position first
+    TTEntry entry;
+    if (tt->probe(board.getHashKey(), entry)) {
+        auto it = std::find(moves.begin(), moves.end(), entry.move);
+        if (it != moves.end()) {
+            std::rotate(moves.begin(), it, it + 1);
+        }
+    }
 
-    for (const auto& move : moves) {
-        Board newBoard(board);
-        newBoard.makeMove(move);
-        int score = minimax(newBoard, maxDepth - 1,
-                           std::numeric_limits<int>::min(),
-                           std::numeric_limits<int>::max(),
-                           false);
+    std::vector<RootMove> rootMoves;
+    rootMoves.reserve(moves.size());
+    for (const Move& move : moves) {
+        rootMoves.push_back({move, -Infinity});
+    }
 
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = move;
-        }
+    tt->newSearch();
+
+    // Helpers search copies of the position without limits of their own
+    // until the main search is done. Half of them start one ply deeper so
+    // the threads are not all working on the same iteration.
+    std::atomic<bool> helpersStop(false);
+    std::vector<std::thread> threads;
+    for (auto& helper : helpers) {
+        SearchLimits helperLimits;
+        helperLimits.stop = &helpersStop;
+        helper->resetSearch(helperLimits);
+
+        AI* worker = helper.get();
+        threads.emplace_back([worker, board, rootMoves]() mutable {
+            MoveList candidates;
+            worker->iterativeDeepening(board, rootMoves, 1 + worker->threadId % 2, candidates);
+        });
     }
 
-    // Add some randomness among equally good moves
-    std::vector<Move> equalMoves;
-    for (const auto& move : moves) {
-        Board newBoard(board);
-        newBoard.makeMove(move);
-        int score = minimax(newBoard, maxDepth - 1,
-                           std::numeric_limits<int>::min(),
-                           std::numeric_limits<int>::max(),
-                           false);
-        if (score == bestScore) {
-            equalMoves.push_back(move);
-        }
+    MoveList candidates;
+    Move bestMove = iterativeDeepening(board, rootMoves, 1, candidates);
+
+    helpersStop.store(true, std::memory_order_relaxed);
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
-    if (equalMoves.size() > 1) {
-        unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine rng(seed);
-        std::uniform_int_distribution<size_t> dist(0, equalMoves.size() - 1);
-        bestMove = equalMoves[dist(rng)];
+    board.setCurrentTurn(savedTurn);
+
+    // Vary the play among the moves within the margin of the best. The raw
+    // engine output is used because std distributions differ between
+    // standard libraries, and the same seed should replay the same game.
+    if (candidates.size() > 1) {
+        bestMove = candidates[rng() % candidates.size()];
     }
 
+    collectStats(board, bestMove);
     return bestMove;
 }
+
+void AI::collectStats(const Board& board, Move bestMove) {
+    stats.nodes = nodes;
+    stats.depth = completedDepth;
+    for (const auto& helper : helpers) {
+        const SearchStats& helperStats = helper->stats;
+        stats.nodes += helper->nodes;
+        stats.qnodes += helperStats.qnodes;
+        stats.seldepth = std::max(stats.seldepth, helperStats.seldepth);
+        stats.betaCutoffs += helperStats.betaCutoffs;
+        stats.firstMoveCutoffs += helperStats.firstMoveCutoffs;
+        stats.hashProbes += helperStats.hashProbes;
+        stats.hashHits += helperStats.hashHits;
+    }
+    stats.timeMs = elapsedMs();
+    stats.nodesPerSecond = stats.timeMs > 0 ? stats.nodes * 1000 / stats.timeMs : stats.nodes;
+    stats.hashfull = tt->hashfull();
+    extractPV(board, bestMove, stats.pv);
+}
+
+void AI::reportIteration(const Board& board, Move bestMove) {
+    // Helpers are still running, so only the main search's own counters
+    // can be read here
+    stats.nodes = nodes;
+    stats.depth = completedDepth;
+    stats.timeMs = elapsedMs();
+    stats.nodesPerSecond = stats.timeMs > 0 ? stats.nodes * 1000 / stats.timeMs : stats.nodes;
+    stats.hashfull = tt->hashfull();
+    extractPV(board, bestMove, stats.pv);
+    iterationCallback(stats);
+}
+
+void AI::extractPV(const Board& board, Move bestMove, std::vector<Move>& pv) const {
+    // Principal variation: the given move, then the best moves the table
+    // holds for the positions that follow
+    pv.clear();
+    Board pvBoard = board;
+    pvBoard.setCurrentTurn(aiColor);
+    Move move = bestMove;
+    while (move.isValid() && pv.size() < static_cast<size_t>(std::max(completedDepth, 1)) &&
+           pvBoard.isLegalMove(pvBoard.getCurrentTurn(), move)) {
+        pv.push_back(move);
+        pvBoard.makeMove(move);
+
+        TTEntry entry;
+        move = tt->probe(pvBoard.getHashKey(), entry) ? entry.move : Move();
+    }
+}
+
+std::string SearchStats::toString() const {
+    std::ostringstream out;
+    out << "depth " << depth << " seldepth " << seldepth << " score " << score
+        << " time " << timeMs << " ms\n"
+        << "nodes " << nodes << " (quiescence " << qnodes << ") nps " << nodesPerSecond << "\n"
+        << "first move cutoffs " << static_cast<int>(firstMoveCutoffRate() * 100 + 0.5) << "%"
+        << " hash hits " << static_cast<int>(hashHitRate() * 100 + 0.5) << "%\n";
+    for (const IterationStats& iteration : iterations) {
+        out << "  iteration " << iteration.depth << ": score " << iteration.score
+            << " nodes " << iteration.nodes << " time " << iteration.timeMs << " ms\n";
+    }
+    out << "pv";
+    for (const Move& move : pv) {
+        out << ' ' << move.toString();
+    }
+    return out.str();
+}
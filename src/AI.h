@@ -2,33 +2,199 @@
 
 #include "Board.h"
 #include "Move.h"
+#include "MovePicker.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Limits for one search. Zero (or null) means no limit; the first
+// iteration always completes so there is a move to play.
+struct SearchLimits {
+    int depth = 0;                            // Deepest iteration
+    int softTimeMs = 0;                       // Start no new iteration after this
+    int hardTimeMs = 0;                       // Abort the running iteration after this
+    uint64_t nodes = 0;                       // Abort after this many nodes
+    const std::atomic<bool>* stop = nullptr;  // Abort once set (from another thread)
+};
+
+// A legal move at the root and its score in the last iteration
+struct RootMove {
+    Move move;
+    int score;
+};
+
+// One completed iteration of the main search
+struct IterationStats {
+    int depth;
+    int score;       // From the searching side's point of view
+    uint64_t nodes;  // Main search nodes so far
+    int timeMs;      // Time since the search started
+};
+
+// What the last search did, for monitoring and spotting regressions.
+// Counters include the Lazy SMP helpers.
+struct SearchStats {
+    uint64_t nodes = 0;             // Every node visited, quiescence included
+    uint64_t qnodes = 0;            // Quiescence nodes
+    uint64_t nodesPerSecond = 0;
+    int depth = 0;                  // Last completed iteration
+    int seldepth = 0;               // Deepest ply reached
+    int score = 0;
+    int timeMs = 0;
+    int hashfull = 0;               // Permille of the table used by this search
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;  // Beta cutoffs by the first move searched
+    uint64_t hashProbes = 0;
+    uint64_t hashHits = 0;
+    std::vector<IterationStats> iterations;
+    std::vector<Move> pv;           // Principal variation, starting with the move played
+
+    double firstMoveCutoffRate() const {
+        return betaCutoffs ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+    }
+    double hashHitRate() const {
+        return hashProbes ? static_cast<double>(hashHits) / hashProbes : 0.0;
+    }
+
+    // Multi-line human readable summary
+    std::string toString() const;
+};
+
+// Selective search techniques. Each can be switched off on its own, e.g.
+// to measure what it is worth.
+struct SearchOptions {
+    bool nullMove = true;            // Prune when passing still holds beta
+    bool lateMoveReductions = true;  // Search late quiet moves shallower
+    bool futilityPruning = true;     // Skip quiet moves near the leaves far below alpha
+    bool razoring = true;            // Drop to quiescence far below alpha near the leaves
+};
 
 class AI {
 private:
+    static constexpr int MaxPly = 64;
+    static constexpr int Infinity = MateScore + 1;
+
     int maxDepth;
     Color aiColor;
+    int timeLimitMs;
+    SearchOptions options;
+    int threadId;  // 0: the main search, else a Lazy SMP helper
+
+    // Move variety: the move played is drawn from those scoring within
+    // randomMargin of the best
+    int randomMargin;
+    uint64_t randomSeed;
+    std::mt19937_64 rng;
+
+    // State of the running search
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t nodes;
+    int completedDepth;
+    bool aborted;
+    SearchStats stats;
+    std::function<void(const SearchStats&)> iterationCallback;
 
-    // Piece-Square Tables for positional evaluation
-    static const int pawnTable[8][8];
-    static const int knightTable[8][8];
-    static const int bishopTable[8][8];
-    static const int rookTable[8][8];
-    static const int queenTable[8][8];
-    static const int kingMiddleGameTable[8][8];
-    static const int kingEndGameTable[8][8];
+    // Two quiet moves per ply that recently caused a beta cutoff
+    Move killers[MaxPly][2];
 
-    int evaluate(const Board& board) const;
-    int getPieceSquareValue(const Piece* piece, bool isEndGame) const;
-    bool isEndGame(const Board& board) const;
+    // Butterfly history and counter moves for ordering quiet moves; aged,
+    // not cleared, between searches
+    MoveHistory history;
 
-    int minimax(Board& board, int depth, int alpha, int beta, bool maximizing);
-    void orderMoves(std::vector<Move>& moves, Board& board);
+    // Kept between moves: positions from the last search often recur.
+    // Shared with the helpers.
+    std::shared_ptr<TranspositionTable> tt;
+
+    // Lazy SMP: helpers search the same root on their own threads and share
+    // what they find only through the transposition table
+    std::vector<std::unique_ptr<AI>> helpers;
+
+    AI(Color color, std::shared_ptr<TranspositionTable> table, int id);
+
+    int evaluate(const Board& board) const;  // From the side to move's point of view
+
+    // Negamax: scores are from the side to move's point of view
+    int searchRoot(Board& board, std::vector<RootMove>& rootMoves, int depth, int alpha, int beta);
+    int search(Board& board, int depth, int ply, int alpha, int beta, bool allowNull = true);
+    int quiescence(Board& board, int ply, int alpha, int beta);
+    Move iterativeDeepening(Board& board, std::vector<RootMove>& rootMoves, int firstDepth,
+                            MoveList& candidates);
+    void resetSearch(const SearchLimits& searchLimits);
+    void collectStats(const Board& board, Move bestMove);
+    void reportIteration(const Board& board, Move bestMove);
+    void extractPV(const Board& board, Move bestMove, std::vector<Move>& pv) const;
+    bool shouldStop();
+    int elapsedMs() const;
+    void orderMoves(MoveList& moves, const Board& board) const;
+    void storeKiller(int ply, const Move& move);
 
 public:
     AI(Color color, int depth = 4);
 
+    // Iterative deepening up to the depth setting (0: no depth cap) within
+    // the time limit, if one is set. Returns the best move of the last
+    // completed iteration.
     Move getBestMove(Board& board);
+    Move getBestMove(Board& board, const SearchLimits& searchLimits);
+
+    // The limits getBestMove(board) uses, from the depth and time settings
+    SearchLimits getSearchLimits() const;
+
+    // Side the AI plays; getBestMove searches for this side
+    void setColor(Color color);
+    Color getColor() const { return aiColor; }
+
     void setDepth(int depth) { maxDepth = depth; }
     int getDepth() const { return maxDepth; }
+
+    // Per-move time budget in milliseconds (0: none). A new iteration is only
+    // started in the first half of the budget.
+    void setTimeLimit(int ms) { timeLimitMs = ms; }
+    int getTimeLimit() const { return timeLimitMs; }
+    int getCompletedDepth() const { return completedDepth; }
+
+    // Statistics of the last getBestMove call
+    const SearchStats& getLastSearchStats() const { return stats; }
+
+    // Called on the searching thread after each completed iteration, with
+    // the statistics so far (main search counters only, as the helpers
+    // are still running)
+    void setIterationCallback(std::function<void(const SearchStats&)> callback) {
+        iterationCallback = std::move(callback);
+    }
+
+    // Play any move scoring within margin centipawns of the best one
+    // (0: only moves tied with the best). Larger margins cost search time.
+    void setRandomMargin(int centipawns) { randomMargin = std::max(centipawns, 0); }
+    int getRandomMargin() const { return randomMargin; }
+
+    // The seed fixes the choices among candidate moves: the same seed and
+    // the same positions replay the same game (single-threaded, fixed depth).
+    // A random seed is drawn at construction.
+    void setRandomSeed(uint64_t seed) {
+        randomSeed = seed;
+        rng.seed(seed);
+    }
+    uint64_t getRandomSeed() const { return randomSeed; }
+
+    // Applies to the Lazy SMP helpers as well
+    void setSearchOptions(const SearchOptions& searchOptions);
+    const SearchOptions& getSearchOptions() const { return options; }
+
+    // Search threads including the calling one (1: single-threaded)
+    void setThreads(int threads);
+    int getThreads() const { return static_cast<int>(helpers.size()) + 1; }
+
+    // Transposition table size in megabytes (clears the table)
+    void setHashSize(size_t megabytes) { tt->resize(megabytes); }
+    void clearHash() { tt->clear(); }
 };
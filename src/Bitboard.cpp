@@ -0,0 +1,232 @@
+#include "Bitboard.h"
+#include "Piece.h"
+
+namespace Bitboards {
+
+Magic rookMagics[64];
+Magic bishopMagics[64];
+
+namespace {
+
+struct LeaperTables {
+    Bitboard pawn[2][64];
+    Bitboard knight[64];
+    Bitboard king[64];
+
+    LeaperTables() {
+        const int knightOffsets[8][2] = {
+            {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+            {1, -2}, {1, 2}, {2, -1}, {2, 1}
+        };
+
+        for (int sq = 0; sq < 64; ++sq) {
+            int row = rowOf(sq);
+            int col = colOf(sq);
+
+            pawn[0][sq] = pawn[1][sq] = knight[sq] = king[sq] = Empty;
+
+            // White pawns move towards row 0, black pawns towards row 7
+            for (int dc = -1; dc <= 1; dc += 2) {
+                if (Piece::isValidSquare(row - 1, col + dc)) {
+                    pawn[0][sq] |= squareBB(square(row - 1, col + dc));
+                }
+                if (Piece::isValidSquare(row + 1, col + dc)) {
+                    pawn[1][sq] |= squareBB(square(row + 1, col + dc));
+                }
+            }
+
+            for (const auto& offset : knightOffsets) {
+                int r = row + offset[0];
+                int c = col + offset[1];
+                if (Piece::isValidSquare(r, c)) {
+                    knight[sq] |= squareBB(square(r, c));
+                }
+            }
+
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    if (dr == 0 && dc == 0) continue;
+                    if (Piece::isValidSquare(row + dr, col + dc)) {
+                        king[sq] |= squareBB(square(row + dr, col + dc));
+                    }
+                }
+            }
+        }
+    }
+};
+
+const LeaperTables leapers;
+
+constexpr Bitboard FileAMask = 0x0101010101010101ULL;
+constexpr Bitboard FileHMask = FileAMask << 7;
+constexpr Bitboard Row0Mask = 0xFFULL;
+constexpr Bitboard Row7Mask = Row0Mask << 56;
+
+Bitboard rowMask(int row) { return Row0Mask << (8 * row); }
+Bitboard fileMask(int col) { return FileAMask << col; }
+
+Bitboard slidingAttacks(int sq, Bitboard occupied, const int directions[4][2]) {
+    Bitboard attacks = Empty;
+    int row = rowOf(sq);
+    int col = colOf(sq);
+
+    for (int d = 0; d < 4; ++d) {
+        for (int i = 1; i < 8; ++i) {
+            int r = row + directions[d][0] * i;
+            int c = col + directions[d][1] * i;
+            if (!Piece::isValidSquare(r, c)) break;
+
+            Bitboard target = squareBB(square(r, c));
+            attacks |= target;
+            if (occupied & target) break;  // Blocked
+        }
+    }
+
+    return attacks;
+}
+
+const int rookDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+const int bishopDirections[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+// Pseudo-random generator for the magic search (xorshift64*). Fixed seeds
+// keep start-up deterministic.
+class MagicRandom {
+public:
+    explicit MagicRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    // Magics with few set bits are found much faster
+    uint64_t sparse() { return next() & next() & next(); }
+
+private:
+    uint64_t state;
+};
+
+// Rook tables need 102400 entries and bishop tables 5248 in total
+Bitboard rookTable[0x19000];
+Bitboard bishopTable[0x1480];
+
+void initMagics(Magic magics[64], Bitboard* table, const int directions[4][2]) {
+    // Static: too large for small (e.g. WASM) stacks
+    static Bitboard reference[4096];
+#if !defined(CHESS_USE_PEXT)
+    static Bitboard occupancy[4096];
+    static int epoch[4096];
+    static int attempt = 0;
+#endif
+
+    for (int sq = 0; sq < 64; ++sq) {
+        Magic& m = magics[sq];
+
+        // Edge squares never block anything beyond themselves
+        Bitboard edges = ((Row0Mask | Row7Mask) & ~rowMask(rowOf(sq))) |
+                         ((FileAMask | FileHMask) & ~fileMask(colOf(sq)));
+        m.mask = slidingAttacks(sq, Empty, directions) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = (sq == 0) ? table : magics[sq - 1].attacks + (1u << (64 - magics[sq - 1].shift));
+
+        // Enumerate every subset of the mask (Carry-Rippler)
+        int size = 0;
+        Bitboard subset = Empty;
+        do {
+            reference[size] = slidingAttacks(sq, subset, directions);
+#if defined(CHESS_USE_PEXT)
+            m.attacks[_pext_u64(subset, m.mask)] = reference[size];
+#else
+            occupancy[size] = subset;
+#endif
+            ++size;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+
+#if !defined(CHESS_USE_PEXT)
+        // Try random magics until every subset maps to a consistent entry
+        const uint64_t seeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+        MagicRandom rng(seeds[rowOf(sq)]);
+        for (int i = 0; i < size;) {
+            do {
+                m.magic = rng.sparse();
+            } while (popCount((m.mask * m.magic) >> 56) < 6);
+
+            ++attempt;
+            for (i = 0; i < size; ++i) {
+                unsigned idx = m.index(occupancy[i]);
+                if (epoch[idx] < attempt) {
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = reference[i];
+                } else if (m.attacks[idx] != reference[i]) {
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
+
+struct MagicInit {
+    MagicInit() {
+        initMagics(rookMagics, rookTable, rookDirections);
+        initMagics(bishopMagics, bishopTable, bishopDirections);
+    }
+};
+
+const MagicInit magicInit;
+
+struct LineTables {
+    Bitboard between[64][64];
+    Bitboard line[64][64];
+
+    LineTables() {
+        for (int a = 0; a < 64; ++a) {
+            for (int b = 0; b < 64; ++b) {
+                between[a][b] = line[a][b] = Empty;
+                if (a == b) continue;
+
+                Bitboard bBB = squareBB(b);
+                if (slidingAttacks(a, Empty, rookDirections) & bBB) {
+                    line[a][b] = (slidingAttacks(a, Empty, rookDirections) &
+                                  slidingAttacks(b, Empty, rookDirections)) | squareBB(a) | bBB;
+                    between[a][b] = slidingAttacks(a, bBB, rookDirections) &
+                                    slidingAttacks(b, squareBB(a), rookDirections);
+                } else if (slidingAttacks(a, Empty, bishopDirections) & bBB) {
+                    line[a][b] = (slidingAttacks(a, Empty, bishopDirections) &
+                                  slidingAttacks(b, Empty, bishopDirections)) | squareBB(a) | bBB;
+                    between[a][b] = slidingAttacks(a, bBB, bishopDirections) &
+                                    slidingAttacks(b, squareBB(a), bishopDirections);
+                }
+            }
+        }
+    }
+};
+
+const LineTables lines;
+
+} // namespace
+
+Bitboard pawnAttacks(Color color, int sq) {
+    return leapers.pawn[static_cast<int>(color)][sq];
+}
+
+Bitboard knightAttacks(int sq) {
+    return leapers.knight[sq];
+}
+
+Bitboard kingAttacks(int sq) {
+    return leapers.king[sq];
+}
+
+Bitboard between(int a, int b) {
+    return lines.between[a][b];
+}
+
+Bitboard line(int a, int b) {
+    return lines.line[a][b];
+}
+
+} // namespace Bitboards
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(CHESS_USE_PEXT)
+#include <immintrin.h>
+#endif
+
+enum class Color;
+
+// 64-bit square set. Square index = row * 8 + col, so index 0 is a8
+// (row 0, black's back rank) and index 63 is h1, matching Board's rows.
+using Bitboard = uint64_t;
+
+namespace Bitboards {
+
+constexpr Bitboard Empty = 0ULL;
+
+inline int square(int row, int col) { return row * 8 + col; }
+inline int rowOf(int sq) { return sq >> 3; }
+inline int colOf(int sq) { return sq & 7; }
+inline Bitboard squareBB(int sq) { return 1ULL << sq; }
+
+inline int popCount(Bitboard b) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(b));
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+// Index of the least significant set bit. b must be non-empty.
+inline int lsb(Bitboard b) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, b);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+inline int popLsb(Bitboard& b) {
+    int sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
+
+// Leaper attacks (precomputed)
+Bitboard pawnAttacks(Color color, int sq);
+Bitboard knightAttacks(int sq);
+Bitboard kingAttacks(int sq);
+
+// Table-driven slider attacks. Each square owns a slice of a shared attack
+// table indexed by its relevant occupancy: a magic multiply-and-shift by
+// default, or a BMI2 PEXT when built with CHESS_USE_PEXT.
+struct Magic {
+    Bitboard mask;      // Relevant blockers (board edges excluded)
+    Bitboard magic;
+    Bitboard* attacks;
+    unsigned shift;
+
+    unsigned index(Bitboard occupied) const {
+#if defined(CHESS_USE_PEXT)
+        return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+        return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+extern Magic rookMagics[64];
+extern Magic bishopMagics[64];
+
+inline Bitboard rookAttacks(int sq, Bitboard occupied) {
+    const Magic& m = rookMagics[sq];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard bishopAttacks(int sq, Bitboard occupied) {
+    const Magic& m = bishopMagics[sq];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queenAttacks(int sq, Bitboard occupied) {
+    return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+}
+
+// Squares strictly between a and b if they share a rank, file or diagonal
+Bitboard between(int a, int b);
+// Full line through a and b (edge to edge) if they are aligned, else empty
+Bitboard line(int a, int b);
+
+} // namespace Bitboards
@@ -5,487 +5,993 @@
 #include "Pieces/Bishop.h"
 #include "Pieces/Knight.h"
 #include "Pieces/Pawn.h"
-
-Board::Board()
-    : currentTurn(Color::White),
-      whiteCanCastleKingside(true), whiteCanCastleQueenside(true),
-      blackCanCastleKingside(true), blackCanCastleQueenside(true),
-      whiteKingRow(7), whiteKingCol(4),
-      blackKingRow(0), blackKingCol(4) {
-    // Initialize all squares to nullptr first
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            squares[r][c] = nullptr;
-        }
+#include "Zobrist.h"
+#include "PieceSquareTables.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Board>::value,
+              "Board must stay trivially copyable so search copies are cheap");
+
+using namespace Bitboards;
+
+namespace {
+
+std::unique_ptr<Piece> createPiece(PieceType type, Color color, int row, int col) {
+    switch (type) {
+        case PieceType::King:   return std::make_unique<King>(color, row, col);
+        case PieceType::Queen:  return std::make_unique<Queen>(color, row, col);
+        case PieceType::Rook:   return std::make_unique<Rook>(color, row, col);
+        case PieceType::Bishop: return std::make_unique<Bishop>(color, row, col);
+        case PieceType::Knight: return std::make_unique<Knight>(color, row, col);
+        case PieceType::Pawn:   return std::make_unique<Pawn>(color, row, col);
+        default: return nullptr;
     }
 }
 
-Board::Board(const Board& other)
-    : currentTurn(other.currentTurn),
-      lastMove(other.lastMove),
-      whiteCanCastleKingside(other.whiteCanCastleKingside),
-      whiteCanCastleQueenside(other.whiteCanCastleQueenside),
-      blackCanCastleKingside(other.blackCanCastleKingside),
-      blackCanCastleQueenside(other.blackCanCastleQueenside),
-      whiteKingRow(other.whiteKingRow), whiteKingCol(other.whiteKingCol),
-      blackKingRow(other.blackKingRow), blackKingCol(other.blackKingCol) {
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            if (other.squares[r][c]) {
-                squares[r][c] = other.squares[r][c]->clone();
-            } else {
-                squares[r][c] = nullptr;
+// One immutable Piece per (color, type, square), shared by every Board
+struct PieceTable {
+    std::unique_ptr<Piece> pieces[2][6][64];
+
+    PieceTable() {
+        for (int c = 0; c < 2; ++c) {
+            for (int t = 0; t < 6; ++t) {
+                for (int sq = 0; sq < 64; ++sq) {
+                    pieces[c][t][sq] = createPiece(static_cast<PieceType>(t), static_cast<Color>(c),
+                                                   rowOf(sq), colOf(sq));
+                }
             }
         }
     }
+};
+
+const PieceTable& pieceTable() {
+    static const PieceTable table;
+    return table;
 }
 
-Board& Board::operator=(const Board& other) {
-    if (this != &other) {
-        clearBoard();
-        currentTurn = other.currentTurn;
-        lastMove = other.lastMove;
-        whiteCanCastleKingside = other.whiteCanCastleKingside;
-        whiteCanCastleQueenside = other.whiteCanCastleQueenside;
-        blackCanCastleKingside = other.blackCanCastleKingside;
-        blackCanCastleQueenside = other.blackCanCastleQueenside;
-        whiteKingRow = other.whiteKingRow;
-        whiteKingCol = other.whiteKingCol;
-        blackKingRow = other.blackKingRow;
-        blackKingCol = other.blackKingCol;
-
-        for (int r = 0; r < 8; ++r) {
-            for (int c = 0; c < 8; ++c) {
-                if (other.squares[r][c]) {
-                    squares[r][c] = other.squares[r][c]->clone();
-                } else {
-                    squares[r][c] = nullptr;
-                }
-            }
-        }
+// Castling rights that survive a move touching the given square
+uint8_t castlingMask(int sq) {
+    switch (sq) {
+        case 0:  return AllCastling & ~BlackQueenside;                    // a8
+        case 4:  return AllCastling & ~(BlackKingside | BlackQueenside);  // e8
+        case 7:  return AllCastling & ~BlackKingside;                     // h8
+        case 56: return AllCastling & ~WhiteQueenside;                    // a1
+        case 60: return AllCastling & ~(WhiteKingside | WhiteQueenside);  // e1
+        case 63: return AllCastling & ~WhiteKingside;                     // h1
+        default: return AllCastling;
     }
-    return *this;
 }
 
-Board::~Board() {
+} // namespace
+
+Board::Board()
+    : currentTurn(Color::White),
+      castlingRights(AllCastling),
+      enPassantSquare(-1) {
     clearBoard();
+    kingSquare[0] = static_cast<int8_t>(square(7, 4));
+    kingSquare[1] = static_cast<int8_t>(square(0, 4));
+    hashKey = computeHashKey();
 }
 
 void Board::clearBoard() {
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            delete squares[r][c];
-            squares[r][c] = nullptr;
+    for (int c = 0; c < 2; ++c) {
+        for (int t = 0; t < 6; ++t) {
+            pieceBB[c][t] = Empty;
         }
+        colorBB[c] = Empty;
     }
+    occupiedBB = Empty;
+    for (int sq = 0; sq < 64; ++sq) {
+        mailbox[sq] = NoPiece;
+    }
+    midgameScore[0] = midgameScore[1] = 0;
+    endgameScore[0] = endgameScore[1] = 0;
+    phase = 0;
+    attackCache.valid = 0;
+    hashKey = computeHashKey();
 }
 
 void Board::setupInitialPosition() {
     clearBoard();
 
-    // Black pieces (top)
-    squares[0][0] = new Rook(Color::Black, 0, 0);
-    squares[0][1] = new Knight(Color::Black, 0, 1);
-    squares[0][2] = new Bishop(Color::Black, 0, 2);
-    squares[0][3] = new Queen(Color::Black, 0, 3);
-    squares[0][4] = new King(Color::Black, 0, 4);
-    squares[0][5] = new Bishop(Color::Black, 0, 5);
-    squares[0][6] = new Knight(Color::Black, 0, 6);
-    squares[0][7] = new Rook(Color::Black, 0, 7);
+    const PieceType backRank[8] = {
+        PieceType::Rook, PieceType::Knight, PieceType::Bishop, PieceType::Queen,
+        PieceType::King, PieceType::Bishop, PieceType::Knight, PieceType::Rook
+    };
 
     for (int c = 0; c < 8; ++c) {
-        squares[1][c] = new Pawn(Color::Black, 1, c);
+        // Black pieces (top)
+        putPiece(square(0, c), backRank[c], Color::Black);
+        putPiece(square(1, c), PieceType::Pawn, Color::Black);
+
+        // White pieces (bottom)
+        putPiece(square(6, c), PieceType::Pawn, Color::White);
+        putPiece(square(7, c), backRank[c], Color::White);
     }
 
-    // White pieces (bottom)
-    squares[7][0] = new Rook(Color::White, 7, 0);
-    squares[7][1] = new Knight(Color::White, 7, 1);
-    squares[7][2] = new Bishop(Color::White, 7, 2);
-    squares[7][3] = new Queen(Color::White, 7, 3);
-    squares[7][4] = new King(Color::White, 7, 4);
-    squares[7][5] = new Bishop(Color::White, 7, 5);
-    squares[7][6] = new Knight(Color::White, 7, 6);
-    squares[7][7] = new Rook(Color::White, 7, 7);
+    currentTurn = Color::White;
+    lastMove = Move();
+    castlingRights = AllCastling;
+    enPassantSquare = -1;
+    hashKey = computeHashKey();
+}
 
-    for (int c = 0; c < 8; ++c) {
-        squares[6][c] = new Pawn(Color::White, 6, c);
+bool Board::loadFEN(const std::string& fen) {
+    std::istringstream in(fen);
+    std::string placement, side, castling, enPassant;
+    if (!(in >> placement >> side)) return false;
+    if (!(in >> castling)) castling = "-";
+    if (!(in >> enPassant)) enPassant = "-";
+
+    // Build into a scratch board so a malformed FEN leaves this one untouched
+    Board result;
+    result.clearBoard();
+
+    int row = 0, col = 0;
+    for (char ch : placement) {
+        if (ch == '/') {
+            if (col != 8) return false;
+            ++row;
+            col = 0;
+        } else if (ch >= '1' && ch <= '8') {
+            col += ch - '0';
+            if (col > 8) return false;
+        } else {
+            PieceType type;
+            switch (ch | 0x20) {  // Lower case
+                case 'k': type = PieceType::King; break;
+                case 'q': type = PieceType::Queen; break;
+                case 'r': type = PieceType::Rook; break;
+                case 'b': type = PieceType::Bishop; break;
+                case 'n': type = PieceType::Knight; break;
+                case 'p': type = PieceType::Pawn; break;
+                default: return false;
+            }
+            if (row > 7 || col > 7) return false;
+            Color color = (ch >= 'A' && ch <= 'Z') ? Color::White : Color::Black;
+            result.putPiece(square(row, col), type, color);
+            ++col;
+        }
+    }
+    if (row != 7 || col != 8) return false;
+    if (popCount(result.getPieces(Color::White, PieceType::King)) != 1 ||
+        popCount(result.getPieces(Color::Black, PieceType::King)) != 1) {
+        return false;
     }
 
-    currentTurn = Color::White;
-    whiteCanCastleKingside = true;
-    whiteCanCastleQueenside = true;
-    blackCanCastleKingside = true;
-    blackCanCastleQueenside = true;
-    whiteKingRow = 7;
-    whiteKingCol = 4;
-    blackKingRow = 0;
-    blackKingCol = 4;
+    if (side == "w") {
+        result.currentTurn = Color::White;
+    } else if (side == "b") {
+        result.currentTurn = Color::Black;
+    } else {
+        return false;
+    }
+
+    result.castlingRights = 0;
+    for (char ch : castling) {
+        switch (ch) {
+            case 'K': result.castlingRights |= WhiteKingside; break;
+            case 'Q': result.castlingRights |= WhiteQueenside; break;
+            case 'k': result.castlingRights |= BlackKingside; break;
+            case 'q': result.castlingRights |= BlackQueenside; break;
+            case '-': break;
+            default: return false;
+        }
+    }
+
+    result.enPassantSquare = -1;
+    if (enPassant != "-") {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' ||
+            (enPassant[1] != '3' && enPassant[1] != '6')) {
+            return false;
+        }
+        result.enPassantSquare = static_cast<int8_t>(square('8' - enPassant[1], enPassant[0] - 'a'));
+    }
+
+    result.lastMove = Move();
+    result.hashKey = result.computeHashKey();
+    *this = result;
+    return true;
 }
 
-Piece* Board::getPiece(int row, int col) const {
-    if (!Piece::isValidSquare(row, col)) return nullptr;
-    return squares[row][col];
+std::string Board::toFEN() const {
+    const char symbols[2][6] = {
+        {'K', 'Q', 'R', 'B', 'N', 'P'},
+        {'k', 'q', 'r', 'b', 'n', 'p'}
+    };
+
+    std::string fen;
+    for (int row = 0; row < 8; ++row) {
+        int empty = 0;
+        for (int col = 0; col < 8; ++col) {
+            uint8_t code = mailbox[square(row, col)];
+            if (code == NoPiece) {
+                ++empty;
+                continue;
+            }
+            if (empty) {
+                fen += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            fen += symbols[static_cast<int>(codeColor(code))][static_cast<int>(codeType(code))];
+        }
+        if (empty) fen += static_cast<char>('0' + empty);
+        if (row < 7) fen += '/';
+    }
+
+    fen += (currentTurn == Color::Black) ? " b " : " w ";
+
+    if (castlingRights == 0) {
+        fen += '-';
+    } else {
+        if (castlingRights & WhiteKingside) fen += 'K';
+        if (castlingRights & WhiteQueenside) fen += 'Q';
+        if (castlingRights & BlackKingside) fen += 'k';
+        if (castlingRights & BlackQueenside) fen += 'q';
+    }
+
+    fen += ' ';
+    if (enPassantSquare >= 0) {
+        fen += static_cast<char>('a' + colOf(enPassantSquare));
+        fen += static_cast<char>('8' - rowOf(enPassantSquare));
+    } else {
+        fen += '-';
+    }
+
+    fen += " 0 1";
+    return fen;
 }
 
-void Board::setPiece(int row, int col, Piece* piece) {
-    if (!Piece::isValidSquare(row, col)) return;
-    squares[row][col] = piece;
-    if (piece) {
-        piece->setPosition(row, col);
+void Board::putPiece(int sq, PieceType type, Color color) {
+    int c = static_cast<int>(color);
+    Bitboard b = squareBB(sq);
+    pieceBB[c][static_cast<int>(type)] |= b;
+    colorBB[c] |= b;
+    occupiedBB |= b;
+    mailbox[sq] = makePieceCode(type, color);
+    hashKey ^= Zobrist::pieceSquare[c][static_cast<int>(type)][sq];
+    midgameScore[c] += PieceSquare::midgame[c][static_cast<int>(type)][sq];
+    endgameScore[c] += PieceSquare::endgame[c][static_cast<int>(type)][sq];
+    phase += PieceSquare::phaseWeight[static_cast<int>(type)];
+    attackCache.valid = 0;
+    if (type == PieceType::King) {
+        kingSquare[c] = static_cast<int8_t>(sq);
     }
 }
 
-void Board::removePiece(int row, int col) {
-    if (!Piece::isValidSquare(row, col)) return;
-    delete squares[row][col];
-    squares[row][col] = nullptr;
+void Board::removePieceAt(int sq) {
+    uint8_t code = mailbox[sq];
+    if (code == NoPiece) return;
+
+    int c = static_cast<int>(codeColor(code));
+    int t = static_cast<int>(codeType(code));
+    Bitboard b = squareBB(sq);
+    pieceBB[c][t] &= ~b;
+    colorBB[c] &= ~b;
+    occupiedBB &= ~b;
+    mailbox[sq] = NoPiece;
+    hashKey ^= Zobrist::pieceSquare[c][t][sq];
+    midgameScore[c] -= PieceSquare::midgame[c][t][sq];
+    endgameScore[c] -= PieceSquare::endgame[c][t][sq];
+    phase -= PieceSquare::phaseWeight[t];
+    attackCache.valid = 0;
 }
 
-void Board::updateKingPosition(Color color, int row, int col) {
-    if (color == Color::White) {
-        whiteKingRow = row;
-        whiteKingCol = col;
-    } else {
-        blackKingRow = row;
-        blackKingCol = col;
+void Board::movePieceBB(int from, int to) {
+    uint8_t code = mailbox[from];
+    int c = static_cast<int>(codeColor(code));
+    int t = static_cast<int>(codeType(code));
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    pieceBB[c][t] ^= fromTo;
+    colorBB[c] ^= fromTo;
+    occupiedBB ^= fromTo;
+    mailbox[to] = code;
+    mailbox[from] = NoPiece;
+    hashKey ^= Zobrist::pieceSquare[c][t][from] ^ Zobrist::pieceSquare[c][t][to];
+    midgameScore[c] += PieceSquare::midgame[c][t][to] - PieceSquare::midgame[c][t][from];
+    endgameScore[c] += PieceSquare::endgame[c][t][to] - PieceSquare::endgame[c][t][from];
+    attackCache.valid = 0;
+    if (codeType(code) == PieceType::King) {
+        kingSquare[c] = static_cast<int8_t>(to);
     }
 }
 
-void Board::updateCastlingRights(const Move& move, Piece* movedPiece) {
-    if (!movedPiece) return;
-
-    Color color = movedPiece->getColor();
-    PieceType type = movedPiece->getType();
+uint64_t Board::enPassantKey() const {
+    // Only hash the en passant file when the side to move can actually capture,
+    // so positions that differ only by a dead en passant square share a key
+    if (enPassantSquare < 0 || currentTurn == Color::None) return 0;
+    Color mover = Piece::oppositeColor(currentTurn);
+    if (!(pawnAttacks(mover, enPassantSquare) & getPieces(currentTurn, PieceType::Pawn))) return 0;
+    return Zobrist::enPassantFile[colOf(enPassantSquare)];
+}
 
-    // King moved
-    if (type == PieceType::King) {
-        if (color == Color::White) {
-            whiteCanCastleKingside = false;
-            whiteCanCastleQueenside = false;
-        } else {
-            blackCanCastleKingside = false;
-            blackCanCastleQueenside = false;
+uint64_t Board::computeHashKey() const {
+    uint64_t key = 0;
+    for (int sq = 0; sq < 64; ++sq) {
+        uint8_t code = mailbox[sq];
+        if (code != NoPiece) {
+            key ^= Zobrist::pieceSquare[static_cast<int>(codeColor(code))][static_cast<int>(codeType(code))][sq];
         }
     }
+    if (currentTurn == Color::Black) key ^= Zobrist::blackToMove;
+    key ^= Zobrist::castling[castlingRights];
+    key ^= enPassantKey();
+    return key;
+}
 
-    // Rook moved
-    if (type == PieceType::Rook) {
-        if (color == Color::White) {
-            if (move.fromRow == 7 && move.fromCol == 0) {
-                whiteCanCastleQueenside = false;
-            } else if (move.fromRow == 7 && move.fromCol == 7) {
-                whiteCanCastleKingside = false;
-            }
-        } else {
-            if (move.fromRow == 0 && move.fromCol == 0) {
-                blackCanCastleQueenside = false;
-            } else if (move.fromRow == 0 && move.fromCol == 7) {
-                blackCanCastleKingside = false;
-            }
-        }
+void Board::verifyHashKey() const {
+#if defined(CHESS_DEBUG_HASH)
+    // Enabled independently of NDEBUG so it also works in release builds
+    if (hashKey != computeHashKey()) {
+        std::fprintf(stderr, "Board: incremental hash key mismatch after %s\n",
+                     lastMove.toString().c_str());
+        std::abort();
+    }
+#endif
+}
+
+const Piece* Board::getPiece(int row, int col) const {
+    if (!Piece::isValidSquare(row, col)) return nullptr;
+    uint8_t code = mailbox[square(row, col)];
+    if (code == NoPiece) return nullptr;
+    return pieceTable().pieces[static_cast<int>(codeColor(code))]
+                              [static_cast<int>(codeType(code))]
+                              [square(row, col)].get();
+}
+
+void Board::setPiece(int row, int col, PieceType type, Color color) {
+    if (!Piece::isValidSquare(row, col)) return;
+    int sq = square(row, col);
+    removePieceAt(sq);
+    if (type != PieceType::None && color != Color::None) {
+        putPiece(sq, type, color);
     }
+    hashKey = computeHashKey();  // Edits may change en passant availability
+}
 
-    // Rook captured
-    if (move.toRow == 0 && move.toCol == 0) blackCanCastleQueenside = false;
-    if (move.toRow == 0 && move.toCol == 7) blackCanCastleKingside = false;
-    if (move.toRow == 7 && move.toCol == 0) whiteCanCastleQueenside = false;
-    if (move.toRow == 7 && move.toCol == 7) whiteCanCastleKingside = false;
+void Board::removePiece(int row, int col) {
+    if (!Piece::isValidSquare(row, col)) return;
+    removePieceAt(square(row, col));
+    hashKey = computeHashKey();
 }
 
 bool Board::makeMove(const Move& move) {
-    Piece* piece = getPiece(move.fromRow, move.fromCol);
-    if (!piece) return false;
+    UndoInfo undo;
+    return makeMove(move, undo);
+}
 
-    Color color = piece->getColor();
+bool Board::makeMove(const Move& move, UndoInfo& undo) {
+    if (!move.isValid()) return false;
+
+    int from = move.from();
+    int to = move.to();
+    if (mailbox[from] == NoPiece) return false;
+
+    Color color = codeColor(mailbox[from]);
+
+    // Save irreversible state
+    undo.attackCache = attackCache;
+    undo.hashKey = hashKey;
+    undo.lastMove = lastMove;
+    undo.castlingRights = castlingRights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.kingSquare[0] = kingSquare[0];
+    undo.kingSquare[1] = kingSquare[1];
+    undo.capturedPiece = PieceType::None;
+
+    // Remove the old castling and en passant contributions from the key
+    hashKey ^= Zobrist::castling[castlingRights] ^ enPassantKey();
 
     // Handle en passant capture
-    if (move.type == MoveType::EnPassant) {
-        int capturedRow = (color == Color::White) ? move.toRow + 1 : move.toRow - 1;
-        removePiece(capturedRow, move.toCol);
-    }
-
-    // Handle castling
-    if (move.type == MoveType::CastleKingside) {
-        // Move rook
-        Piece* rook = getPiece(move.fromRow, 7);
-        squares[move.fromRow][5] = rook;
-        squares[move.fromRow][7] = nullptr;
-        if (rook) {
-            rook->setPosition(move.fromRow, 5);
-            rook->setHasMoved(true);
-        }
-    } else if (move.type == MoveType::CastleQueenside) {
-        // Move rook
-        Piece* rook = getPiece(move.fromRow, 0);
-        squares[move.fromRow][3] = rook;
-        squares[move.fromRow][0] = nullptr;
-        if (rook) {
-            rook->setPosition(move.fromRow, 3);
-            rook->setHasMoved(true);
-        }
+    if (move.type() == MoveType::EnPassant) {
+        int capturedRow = (color == Color::White) ? move.toRow() + 1 : move.toRow() - 1;
+        int capturedSq = square(capturedRow, move.toCol());
+        undo.capturedPiece = getPieceTypeAt(capturedSq);
+        removePieceAt(capturedSq);
+    } else {
+        // Capture at destination
+        undo.capturedPiece = getPieceTypeAt(to);
+        removePieceAt(to);
     }
 
-    // Capture at destination (not en passant)
-    if (move.type != MoveType::EnPassant) {
-        delete squares[move.toRow][move.toCol];
+    // Handle castling - move rook
+    if (move.type() == MoveType::CastleKingside) {
+        movePieceBB(square(move.fromRow(), 7), square(move.fromRow(), 5));
+    } else if (move.type() == MoveType::CastleQueenside) {
+        movePieceBB(square(move.fromRow(), 0), square(move.fromRow(), 3));
     }
 
     // Move piece
-    squares[move.toRow][move.toCol] = piece;
-    squares[move.fromRow][move.fromCol] = nullptr;
-    piece->setPosition(move.toRow, move.toCol);
-    piece->setHasMoved(true);
+    movePieceBB(from, to);
 
     // Handle promotion
     if (move.isPromotion()) {
-        Piece* promoted = nullptr;
-        switch (move.promotionPiece) {
-            case PieceType::Queen:
-                promoted = new Queen(color, move.toRow, move.toCol);
-                break;
-            case PieceType::Rook:
-                promoted = new Rook(color, move.toRow, move.toCol);
-                break;
-            case PieceType::Bishop:
-                promoted = new Bishop(color, move.toRow, move.toCol);
-                break;
-            case PieceType::Knight:
-                promoted = new Knight(color, move.toRow, move.toCol);
-                break;
-            default:
-                promoted = new Queen(color, move.toRow, move.toCol);
-                break;
-        }
-        promoted->setHasMoved(true);
-        delete squares[move.toRow][move.toCol];
-        squares[move.toRow][move.toCol] = promoted;
-    }
-
-    // Update king position
-    if (piece->getType() == PieceType::King) {
-        updateKingPosition(color, move.toRow, move.toCol);
+        removePieceAt(to);
+        putPiece(to, move.promotionPiece(), color);
     }
 
-    updateCastlingRights(move, piece);
+    enPassantSquare = (move.type() == MoveType::DoublePawnPush)
+        ? static_cast<int8_t>((from + to) / 2) : static_cast<int8_t>(-1);
+    castlingRights &= castlingMask(from) & castlingMask(to);
     lastMove = move;
     switchTurn();
+    hashKey ^= Zobrist::castling[castlingRights] ^ enPassantKey();
 
+    verifyHashKey();
     return true;
 }
 
+void Board::undoMove(const Move& move, const UndoInfo& undo) {
+    switchTurn();
+
+    int from = move.from();
+    int to = move.to();
+    Color color = codeColor(mailbox[to]);
+    Color enemy = Piece::oppositeColor(color);
+
+    // Turn a promoted piece back into a pawn
+    if (move.isPromotion()) {
+        removePieceAt(to);
+        putPiece(to, PieceType::Pawn, color);
+    }
+
+    movePieceBB(to, from);
+
+    // Put the castling rook back
+    if (move.type() == MoveType::CastleKingside) {
+        movePieceBB(square(move.fromRow(), 5), square(move.fromRow(), 7));
+    } else if (move.type() == MoveType::CastleQueenside) {
+        movePieceBB(square(move.fromRow(), 3), square(move.fromRow(), 0));
+    }
+
+    // Restore the captured piece
+    if (undo.capturedPiece != PieceType::None) {
+        if (move.type() == MoveType::EnPassant) {
+            int capturedRow = (color == Color::White) ? move.toRow() + 1 : move.toRow() - 1;
+            putPiece(square(capturedRow, move.toCol()), undo.capturedPiece, enemy);
+        } else {
+            putPiece(to, undo.capturedPiece, enemy);
+        }
+    }
+
+    lastMove = undo.lastMove;
+    castlingRights = undo.castlingRights;
+    enPassantSquare = undo.enPassantSquare;
+    kingSquare[0] = undo.kingSquare[0];
+    kingSquare[1] = undo.kingSquare[1];
+    hashKey = undo.hashKey;
+    attackCache = undo.attackCache;
+    verifyHashKey();
+}
+
+void Board::makeNullMove(UndoInfo& undo) {
+    undo.attackCache = attackCache;
+    undo.hashKey = hashKey;
+    undo.lastMove = lastMove;
+    undo.capturedPiece = PieceType::None;
+    undo.castlingRights = castlingRights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.kingSquare[0] = kingSquare[0];
+    undo.kingSquare[1] = kingSquare[1];
+
+    // Pieces stay put, so the attack cache remains valid
+    hashKey ^= enPassantKey();
+    enPassantSquare = -1;
+    lastMove = Move();
+    switchTurn();
+    verifyHashKey();
+}
+
+void Board::undoNullMove(const UndoInfo& undo) {
+    switchTurn();
+    lastMove = undo.lastMove;
+    enPassantSquare = undo.enPassantSquare;
+    hashKey = undo.hashKey;
+    verifyHashKey();
+}
+
+void Board::setCurrentTurn(Color turn) {
+    if (turn == currentTurn) return;
+    hashKey ^= enPassantKey();
+    currentTurn = turn;
+    hashKey ^= Zobrist::blackToMove ^ enPassantKey();
+}
+
 void Board::switchTurn() {
     currentTurn = Piece::oppositeColor(currentTurn);
+    hashKey ^= Zobrist::blackToMove;
 }
 
-std::vector<Move> Board::getPseudoLegalMoves(Color color) const {
-    std::vector<Move> moves;
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* piece = squares[r][c];
-            if (piece && piece->getColor() == color) {
-                auto pieceMoves = piece->getPseudoLegalMoves(*this);
-                moves.insert(moves.end(), pieceMoves.begin(), pieceMoves.end());
-            }
+void Board::getPseudoLegalMoves(Color color, MoveList& moves) const {
+    Bitboard pieces = colorBB[static_cast<int>(color)];
+    while (pieces) {
+        int sq = popLsb(pieces);
+        getPiece(rowOf(sq), colOf(sq))->getPseudoLegalMoves(*this, moves);
+    }
+}
+
+Bitboard Board::computeKingBlockers(Color color) const {
+    int us = static_cast<int>(color);
+    int them = us ^ 1;
+    int kingSq = kingSquare[us];
+
+    // Enemy sliders that would attack the king through at most one piece
+    Bitboard snipers =
+        (rookAttacks(kingSq, Empty) &
+         (pieceBB[them][static_cast<int>(PieceType::Rook)] | pieceBB[them][static_cast<int>(PieceType::Queen)])) |
+        (bishopAttacks(kingSq, Empty) &
+         (pieceBB[them][static_cast<int>(PieceType::Bishop)] | pieceBB[them][static_cast<int>(PieceType::Queen)]));
+
+    Bitboard blockers = Empty;
+    while (snipers) {
+        int sniperSq = popLsb(snipers);
+        Bitboard inBetween = between(kingSq, sniperSq) & occupiedBB;
+        if (inBetween && !(inBetween & (inBetween - 1))) {
+            blockers |= inBetween;
         }
     }
-    return moves;
+    return blockers;
 }
 
-std::vector<Move> Board::getLegalMoves(Color color) {
-    std::vector<Move> legalMoves;
-    auto pseudoLegalMoves = getPseudoLegalMoves(color);
+Bitboard Board::computeAttacks(Color color) const {
+    const Bitboard (&pieces)[6] = pieceBB[static_cast<int>(color)];
+    Bitboard attacks = Empty;
+
+    Bitboard pawns = pieces[static_cast<int>(PieceType::Pawn)];
+    while (pawns) attacks |= pawnAttacks(color, popLsb(pawns));
+
+    Bitboard knights = pieces[static_cast<int>(PieceType::Knight)];
+    while (knights) attacks |= knightAttacks(popLsb(knights));
+
+    Bitboard diagonal = pieces[static_cast<int>(PieceType::Bishop)] | pieces[static_cast<int>(PieceType::Queen)];
+    while (diagonal) attacks |= bishopAttacks(popLsb(diagonal), occupiedBB);
 
-    for (const auto& move : pseudoLegalMoves) {
-        // Make a copy of the board to test the move
-        Board testBoard(*this);
-        Piece* piece = testBoard.getPiece(move.fromRow, move.fromCol);
-        if (!piece) continue;
+    Bitboard straight = pieces[static_cast<int>(PieceType::Rook)] | pieces[static_cast<int>(PieceType::Queen)];
+    while (straight) attacks |= rookAttacks(popLsb(straight), occupiedBB);
 
-        // Handle en passant capture
-        if (move.type == MoveType::EnPassant) {
-            int capturedRow = (color == Color::White) ? move.toRow + 1 : move.toRow - 1;
-            testBoard.removePiece(capturedRow, move.toCol);
+    Bitboard kings = pieces[static_cast<int>(PieceType::King)];
+    while (kings) attacks |= kingAttacks(popLsb(kings));
+
+    return attacks;
+}
+
+const AttackCache& Board::checkInfo(Color color) const {
+    int c = static_cast<int>(color);
+    uint8_t flag = static_cast<uint8_t>(CheckInfoValid << c);
+    if (!(attackCache.valid & flag)) {
+        int kingSq = kingSquare[c];
+        if (pieceBB[c][static_cast<int>(PieceType::King)] & squareBB(kingSq)) {
+            attackCache.checkers[c] = attackersTo(kingSq, occupiedBB) & colorBB[c ^ 1];
+            attackCache.kingBlockers[c] = computeKingBlockers(color);
+        } else {
+            // No king on the board (edited position)
+            attackCache.checkers[c] = Empty;
+            attackCache.kingBlockers[c] = Empty;
         }
+        attackCache.valid |= flag;
+    }
+    return attackCache;
+}
 
-        // Handle castling - check if squares are attacked
-        if (move.type == MoveType::CastleKingside) {
-            int row = (color == Color::White) ? 7 : 0;
-            if (testBoard.isSquareAttacked(row, 4, Piece::oppositeColor(color)) ||
-                testBoard.isSquareAttacked(row, 5, Piece::oppositeColor(color)) ||
-                testBoard.isSquareAttacked(row, 6, Piece::oppositeColor(color))) {
-                continue;
+const AttackCache& Board::attackInfo(Color color) const {
+    int c = static_cast<int>(color);
+    uint8_t flag = static_cast<uint8_t>(AttacksValid << c);
+    if (!(attackCache.valid & flag)) {
+        attackCache.attacked[c] = computeAttacks(color);
+        attackCache.valid |= flag;
+    }
+    return attackCache;
+}
+
+Bitboard Board::getPinned(Color color) const {
+    int c = static_cast<int>(color);
+    return checkInfo(color).kingBlockers[c] & colorBB[c];
+}
+
+bool Board::isLegalEnPassant(Color color, int from, int to) const {
+    // The captured pawn leaves a square that is neither from nor to, which can
+    // expose the king along the rank or a diagonal; test the resulting occupancy.
+    int us = static_cast<int>(color);
+    int kingSq = kingSquare[us];
+    int capturedSq = (color == Color::White) ? to + 8 : to - 8;
+    Bitboard occupied = (occupiedBB ^ squareBB(from) ^ squareBB(capturedSq)) | squareBB(to);
+
+    Bitboard attackers = attackersTo(kingSq, occupied) & colorBB[us ^ 1] & ~squareBB(capturedSq);
+    return attackers == 0;
+}
+
+void Board::addPawnMoves(Color color, Bitboard targetMask, Bitboard pinned, MoveGen gen,
+                         MoveList& moves) const {
+    int us = static_cast<int>(color);
+    int kingSq = kingSquare[us];
+    int forward = (color == Color::White) ? -8 : 8;
+    int startRow = (color == Color::White) ? 6 : 1;
+    int promotionRow = (color == Color::White) ? 0 : 7;
+    Bitboard enemies = colorBB[us ^ 1];
+
+    // Promotions count as captures: both change material
+    bool tactical = gen != MoveGen::Quiets;
+    bool quiet = gen != MoveGen::Captures;
+
+    // En passant is only available to the side that did not make the double push
+    int epSquare = enPassantSquare;
+    if (epSquare >= 0 && rowOf(epSquare) != ((color == Color::White) ? 2 : 5)) {
+        epSquare = -1;
+    }
+
+    Bitboard pawns = pieceBB[us][static_cast<int>(PieceType::Pawn)];
+    while (pawns) {
+        int from = popLsb(pawns);
+        Bitboard allowed = targetMask;
+        if (pinned & squareBB(from)) {
+            allowed &= line(kingSq, from);
+        }
+
+        // Pushes
+        int to = from + forward;
+        if (!(occupiedBB & squareBB(to))) {
+            if (allowed & squareBB(to)) {
+                if (rowOf(to) == promotionRow) {
+                    if (tactical) {
+                        moves.push_back(Move(from, to, MoveType::Promotion, PieceType::Queen));
+                        moves.push_back(Move(from, to, MoveType::Promotion, PieceType::Rook));
+                        moves.push_back(Move(from, to, MoveType::Promotion, PieceType::Bishop));
+                        moves.push_back(Move(from, to, MoveType::Promotion, PieceType::Knight));
+                    }
+                } else if (quiet) {
+                    moves.push_back(Move(from, to, MoveType::Normal));
+                }
             }
-        } else if (move.type == MoveType::CastleQueenside) {
-            int row = (color == Color::White) ? 7 : 0;
-            if (testBoard.isSquareAttacked(row, 4, Piece::oppositeColor(color)) ||
-                testBoard.isSquareAttacked(row, 3, Piece::oppositeColor(color)) ||
-                testBoard.isSquareAttacked(row, 2, Piece::oppositeColor(color))) {
-                continue;
+
+            int doubleTo = to + forward;
+            if (quiet && rowOf(from) == startRow && !(occupiedBB & squareBB(doubleTo)) &&
+                (allowed & squareBB(doubleTo))) {
+                moves.push_back(Move(from, doubleTo, MoveType::DoublePawnPush));
             }
         }
 
-        // Make the move
-        delete testBoard.squares[move.toRow][move.toCol];
-        testBoard.squares[move.toRow][move.toCol] = testBoard.squares[move.fromRow][move.fromCol];
-        testBoard.squares[move.fromRow][move.fromCol] = nullptr;
-        testBoard.squares[move.toRow][move.toCol]->setPosition(move.toRow, move.toCol);
+        if (!tactical) continue;
+
+        // Captures
+        Bitboard captures = pawnAttacks(color, from) & enemies & allowed;
+        while (captures) {
+            int target = popLsb(captures);
+            if (rowOf(target) == promotionRow) {
+                moves.push_back(Move(from, target, MoveType::PromotionCapture, PieceType::Queen));
+                moves.push_back(Move(from, target, MoveType::PromotionCapture, PieceType::Rook));
+                moves.push_back(Move(from, target, MoveType::PromotionCapture, PieceType::Bishop));
+                moves.push_back(Move(from, target, MoveType::PromotionCapture, PieceType::Knight));
+            } else {
+                moves.push_back(Move(from, target, MoveType::Capture));
+            }
+        }
 
-        // Update king position if king moved
-        if (piece->getType() == PieceType::King) {
-            testBoard.updateKingPosition(color, move.toRow, move.toCol);
+        // En passant (verified separately: it removes two pieces from the line)
+        if (epSquare >= 0 && (pawnAttacks(color, from) & squareBB(epSquare)) &&
+            isLegalEnPassant(color, from, epSquare)) {
+            moves.push_back(Move(from, epSquare, MoveType::EnPassant));
         }
+    }
+}
 
-        // Check if own king is in check after the move
-        if (!testBoard.isInCheck(color)) {
-            legalMoves.push_back(move);
+void Board::getLegalMoves(Color color, MoveList& moves, MoveGen gen) const {
+    moves.clear();
+    if (color == Color::None) return;
+
+    int us = static_cast<int>(color);
+    int them = us ^ 1;
+    int kingSq = kingSquare[us];
+    Bitboard ours = colorBB[us];
+    Bitboard kingBB = pieceBB[us][static_cast<int>(PieceType::King)] & squareBB(kingSq);
+    if (!kingBB) {
+        // No king on the board (edited position): fall back to pseudo-legal moves
+        getPseudoLegalMoves(color, moves);
+        if (gen != MoveGen::All) {
+            bool captures = gen == MoveGen::Captures;
+            size_t count = 0;
+            for (size_t i = 0; i < moves.size(); ++i) {
+                if ((moves[i].isCapture() || moves[i].isPromotion()) == captures) {
+                    moves[count++] = moves[i];
+                }
+            }
+            moves.resize(count);
         }
+        return;
     }
 
-    return legalMoves;
-}
+    Bitboard checkers = getCheckers(color);
+    Bitboard pinned = getPinned(color);
+
+    // Destination squares for the requested subset (pawns are filtered by gen)
+    Bitboard genMask = ~ours;
+    if (gen == MoveGen::Captures) genMask = colorBB[them];
+    if (gen == MoveGen::Quiets) genMask = ~occupiedBB;
+
+    // King moves: the king itself must not shield the destination from sliders
+    Bitboard occupiedWithoutKing = occupiedBB ^ kingBB;
+    Bitboard kingTargets = kingAttacks(kingSq) & genMask;
+    while (kingTargets) {
+        int to = popLsb(kingTargets);
+        if (attackersTo(to, occupiedWithoutKing) & colorBB[them]) continue;
+        moves.push_back(Move(kingSq, to, (mailbox[to] != NoPiece) ? MoveType::Capture : MoveType::Normal));
+    }
 
-std::vector<Move> Board::getLegalMovesForPiece(int row, int col) {
-    Piece* piece = getPiece(row, col);
-    if (!piece) return {};
+    // Double check: only the king can move
+    if (checkers & (checkers - 1)) return;
 
-    Color color = piece->getColor();
-    auto allLegalMoves = getLegalMoves(color);
+    // Single check: other pieces must capture the checker or block
+    Bitboard targetMask = ~ours;
+    if (checkers) {
+        targetMask &= between(kingSq, lsb(checkers)) | checkers;
+    }
 
-    std::vector<Move> pieceMoves;
-    for (const auto& move : allLegalMoves) {
-        if (move.fromRow == row && move.fromCol == col) {
-            pieceMoves.push_back(move);
+    addPawnMoves(color, targetMask, pinned, gen, moves);
+    targetMask &= genMask;
+
+    const PieceType pieceTypes[4] = {
+        PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen
+    };
+    for (PieceType type : pieceTypes) {
+        Bitboard pieces = pieceBB[us][static_cast<int>(type)];
+        while (pieces) {
+            int from = popLsb(pieces);
+            Bitboard targets;
+            switch (type) {
+                case PieceType::Knight: targets = knightAttacks(from); break;
+                case PieceType::Bishop: targets = bishopAttacks(from, occupiedBB); break;
+                case PieceType::Rook:   targets = rookAttacks(from, occupiedBB); break;
+                default:                targets = queenAttacks(from, occupiedBB); break;
+            }
+            targets &= targetMask;
+            if (pinned & squareBB(from)) {
+                targets &= line(kingSq, from);
+            }
+
+            while (targets) {
+                int to = popLsb(targets);
+                moves.push_back(Move(from, to, (mailbox[to] != NoPiece) ? MoveType::Capture : MoveType::Normal));
+            }
         }
     }
 
-    return pieceMoves;
+    // Castling: not out of, through or into check
+    if (checkers || gen == MoveGen::Captures) return;
+    if (isCastlingLegal(color, true)) {
+        moves.push_back(Move(kingSq, kingSq + 2, MoveType::CastleKingside));
+    }
+    if (isCastlingLegal(color, false)) {
+        moves.push_back(Move(kingSq, kingSq - 2, MoveType::CastleQueenside));
+    }
 }
 
-bool Board::isSquareAttacked(int row, int col, Color byColor) const {
-    // Check pawn attacks
-    int pawnDir = (byColor == Color::White) ? 1 : -1;
-    int pawnRow = row + pawnDir;
-    if (Piece::isValidSquare(pawnRow, col - 1)) {
-        Piece* p = squares[pawnRow][col - 1];
-        if (p && p->getType() == PieceType::Pawn && p->getColor() == byColor) {
-            return true;
-        }
+bool Board::isCastlingLegal(Color color, bool kingside) const {
+    // Caller has checked that the king is not in check
+    int them = static_cast<int>(color) ^ 1;
+    int homeRow = (color == Color::White) ? 7 : 0;
+    if (kingSquare[static_cast<int>(color)] != square(homeRow, 4)) return false;
+    if (!(kingside ? canCastleKingside(color) : canCastleQueenside(color))) return false;
+
+    int rookCol = kingside ? 7 : 0;
+    if (mailbox[square(homeRow, rookCol)] != makePieceCode(PieceType::Rook, color)) return false;
+
+    // Squares between king and rook must be empty; the king's path must be safe
+    if (between(square(homeRow, 4), square(homeRow, rookCol)) & occupiedBB) return false;
+    int step = kingside ? 1 : -1;
+    for (int col = 4 + step; col != 4 + 3 * step; col += step) {
+        if (attackersTo(square(homeRow, col), occupiedBB) & colorBB[them]) return false;
     }
-    if (Piece::isValidSquare(pawnRow, col + 1)) {
-        Piece* p = squares[pawnRow][col + 1];
-        if (p && p->getType() == PieceType::Pawn && p->getColor() == byColor) {
-            return true;
+    return true;
+}
+
+MoveList Board::getLegalMoves(Color color) const {
+    MoveList moves;
+    getLegalMoves(color, moves);
+    return moves;
+}
+
+MoveList Board::getLegalMovesForPiece(int row, int col) const {
+    MoveList pieceMoves;
+    const Piece* piece = getPiece(row, col);
+    if (!piece) return pieceMoves;
+
+    getLegalMoves(piece->getColor(), pieceMoves);
+
+    size_t count = 0;
+    for (size_t i = 0; i < pieceMoves.size(); ++i) {
+        if (pieceMoves[i].fromRow() == row && pieceMoves[i].fromCol() == col) {
+            pieceMoves[count++] = pieceMoves[i];
         }
     }
+    pieceMoves.resize(count);
 
-    // Check knight attacks
-    int knightMoves[8][2] = {
-        {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-        {1, -2}, {1, 2}, {2, -1}, {2, 1}
-    };
-    for (const auto& km : knightMoves) {
-        int r = row + km[0];
-        int c = col + km[1];
-        if (Piece::isValidSquare(r, c)) {
-            Piece* p = squares[r][c];
-            if (p && p->getType() == PieceType::Knight && p->getColor() == byColor) {
-                return true;
-            }
-        }
+    return pieceMoves;
+}
+
+bool Board::isLegalMove(Color color, const Move& move) const {
+    if (color == Color::None || !move.isValid()) return false;
+
+    // Reject the unused flag values (6 and 7)
+    if (Move(move.from(), move.to(), move.type(), move.promotionPiece()) != move) return false;
+
+    int us = static_cast<int>(color);
+    int them = us ^ 1;
+    int from = move.from();
+    int to = move.to();
+    uint8_t code = mailbox[from];
+    if (code == NoPiece || codeColor(code) != color) return false;
+    if (colorBB[us] & squareBB(to)) return false;
+
+    int kingSq = kingSquare[us];
+    if (!(pieceBB[us][static_cast<int>(PieceType::King)] & squareBB(kingSq))) {
+        // No king: only the generator knows the pseudo-legal fallback
+        MoveList moves;
+        getLegalMoves(color, moves);
+        return std::find(moves.begin(), moves.end(), move) != moves.end();
     }
 
-    // Check king attacks
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            if (dr == 0 && dc == 0) continue;
-            int r = row + dr;
-            int c = col + dc;
-            if (Piece::isValidSquare(r, c)) {
-                Piece* p = squares[r][c];
-                if (p && p->getType() == PieceType::King && p->getColor() == byColor) {
-                    return true;
-                }
-            }
-        }
+    PieceType type = codeType(code);
+    MoveType moveType = move.type();
+    bool targetOccupied = mailbox[to] != NoPiece;
+    Bitboard checkers = getCheckers(color);
+
+    // The flags must describe what actually happens on this board
+    if (moveType == MoveType::EnPassant) {
+        int epSquare = enPassantSquare;
+        int epRow = (color == Color::White) ? 2 : 5;
+        return type == PieceType::Pawn && to == epSquare && rowOf(epSquare) == epRow &&
+               (pawnAttacks(color, from) & squareBB(to)) && isLegalEnPassant(color, from, to);
+    }
+    if (move.isCastle()) {
+        bool kingside = moveType == MoveType::CastleKingside;
+        return type == PieceType::King && !checkers && to == from + (kingside ? 2 : -2) &&
+               isCastlingLegal(color, kingside);
+    }
+    if (move.isCapture() != targetOccupied) return false;
+    if (type != PieceType::Pawn && (move.isPromotion() || moveType == MoveType::DoublePawnPush)) {
+        return false;
     }
 
-    // Check rook/queen attacks (straight lines)
-    int straightDirs[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-    for (const auto& dir : straightDirs) {
-        for (int i = 1; i < 8; ++i) {
-            int r = row + dir[0] * i;
-            int c = col + dir[1] * i;
-            if (!Piece::isValidSquare(r, c)) break;
-            Piece* p = squares[r][c];
-            if (p) {
-                if (p->getColor() == byColor &&
-                    (p->getType() == PieceType::Rook || p->getType() == PieceType::Queen)) {
-                    return true;
-                }
-                break;
-            }
-        }
+    if (type == PieceType::King) {
+        if (!(kingAttacks(from) & squareBB(to))) return false;
+        Bitboard occupiedWithoutKing = occupiedBB ^ squareBB(from);
+        return !(attackersTo(to, occupiedWithoutKing) & colorBB[them]);
     }
 
-    // Check bishop/queen attacks (diagonals)
-    int diagDirs[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
-    for (const auto& dir : diagDirs) {
-        for (int i = 1; i < 8; ++i) {
-            int r = row + dir[0] * i;
-            int c = col + dir[1] * i;
-            if (!Piece::isValidSquare(r, c)) break;
-            Piece* p = squares[r][c];
-            if (p) {
-                if (p->getColor() == byColor &&
-                    (p->getType() == PieceType::Bishop || p->getType() == PieceType::Queen)) {
-                    return true;
-                }
-                break;
+    if (type == PieceType::Pawn) {
+        int forward = (color == Color::White) ? -8 : 8;
+        int promotionRow = (color == Color::White) ? 0 : 7;
+        if (move.isPromotion() != (rowOf(to) == promotionRow)) return false;
+
+        if (moveType == MoveType::DoublePawnPush) {
+            int startRow = (color == Color::White) ? 6 : 1;
+            if (rowOf(from) != startRow || to != from + 2 * forward ||
+                (occupiedBB & squareBB(from + forward))) {
+                return false;
             }
+        } else if (move.isCapture()) {
+            if (!(pawnAttacks(color, from) & squareBB(to))) return false;
+        } else if (to != from + forward) {
+            return false;
+        }
+    } else {
+        Bitboard attacks;
+        switch (type) {
+            case PieceType::Knight: attacks = knightAttacks(from); break;
+            case PieceType::Bishop: attacks = bishopAttacks(from, occupiedBB); break;
+            case PieceType::Rook:   attacks = rookAttacks(from, occupiedBB); break;
+            default:                attacks = queenAttacks(from, occupiedBB); break;
         }
+        if (!(attacks & squareBB(to))) return false;
     }
 
-    return false;
+    // Same rules as the generator: evade check, and pinned pieces stay on the pin line
+    if (checkers) {
+        if (checkers & (checkers - 1)) return false;
+        if (!((between(kingSq, lsb(checkers)) | checkers) & squareBB(to))) return false;
+    }
+    if ((getPinned(color) & squareBB(from)) && !(line(kingSq, from) & squareBB(to))) {
+        return false;
+    }
+    return true;
+}
+
+Bitboard Board::attackersTo(int sq, Bitboard occupied) const {
+    const Bitboard (&white)[6] = pieceBB[static_cast<int>(Color::White)];
+    const Bitboard (&black)[6] = pieceBB[static_cast<int>(Color::Black)];
+    const int K = static_cast<int>(PieceType::King);
+    const int Q = static_cast<int>(PieceType::Queen);
+    const int R = static_cast<int>(PieceType::Rook);
+    const int B = static_cast<int>(PieceType::Bishop);
+    const int N = static_cast<int>(PieceType::Knight);
+    const int P = static_cast<int>(PieceType::Pawn);
+
+    Bitboard rookLike = white[R] | white[Q] | black[R] | black[Q];
+    Bitboard bishopLike = white[B] | white[Q] | black[B] | black[Q];
+
+    // A white pawn attacks sq if a black pawn on sq would attack it, and vice versa
+    return (pawnAttacks(Color::Black, sq) & white[P]) |
+           (pawnAttacks(Color::White, sq) & black[P]) |
+           (knightAttacks(sq) & (white[N] | black[N])) |
+           (kingAttacks(sq) & (white[K] | black[K])) |
+           (rookAttacks(sq, occupied) & rookLike) |
+           (bishopAttacks(sq, occupied) & bishopLike);
+}
+
+bool Board::isSquareAttacked(int row, int col, Color byColor) const {
+    if (!Piece::isValidSquare(row, col) || byColor == Color::None) return false;
+    return (getAttackedSquares(byColor) & squareBB(square(row, col))) != 0;
 }
 
 bool Board::isInCheck(Color color) const {
-    int kingRow, kingCol;
-    getKingPosition(color, kingRow, kingCol);
-    return isSquareAttacked(kingRow, kingCol, Piece::oppositeColor(color));
+    if (color == Color::None) return false;
+    return getCheckers(color) != 0;
+}
+
+bool Board::givesCheck(const Move& move) const {
+    int from = move.from();
+    int to = move.to();
+    uint8_t code = mailbox[from];
+    if (code == NoPiece) return false;
+
+    Color color = codeColor(code);
+    int them = static_cast<int>(color) ^ 1;
+    int kingSq = kingSquare[them];
+    if (!(pieceBB[them][static_cast<int>(PieceType::King)] & squareBB(kingSq))) return false;
+
+    // Rare moves that change more than one line: play them on a copy
+    if (move.isPromotion() || move.isCastle() || move.type() == MoveType::EnPassant) {
+        Board next(*this);
+        next.makeMove(move);
+        return next.isInCheck(static_cast<Color>(them));
+    }
+
+    // Discovered check: the mover was the only piece shielding the king
+    if ((checkInfo(static_cast<Color>(them)).kingBlockers[them] & squareBB(from)) && !(line(kingSq, from) & squareBB(to))) {
+        return true;
+    }
+
+    // Direct check from the destination square
+    Bitboard occupied = occupiedBB ^ squareBB(from);
+    Bitboard attacks;
+    switch (codeType(code)) {
+        case PieceType::Pawn:   attacks = pawnAttacks(color, to); break;
+        case PieceType::Knight: attacks = knightAttacks(to); break;
+        case PieceType::Bishop: attacks = bishopAttacks(to, occupied); break;
+        case PieceType::Rook:   attacks = rookAttacks(to, occupied); break;
+        case PieceType::Queen:  attacks = queenAttacks(to, occupied); break;
+        default:                attacks = Empty; break;
+    }
+    return (attacks & squareBB(kingSq)) != 0;
 }
 
-bool Board::isCheckmate(Color color) {
+bool Board::isCheckmate(Color color) const {
     if (!isInCheck(color)) return false;
     return getLegalMoves(color).empty();
 }
 
-bool Board::isStalemate(Color color) {
+bool Board::isStalemate(Color color) const {
     if (isInCheck(color)) return false;
     return getLegalMoves(color).empty();
 }
 
 bool Board::isDraw() {
     // Insufficient material check (simplified)
-    int whitePieces = 0, blackPieces = 0;
-    int whiteMinor = 0, blackMinor = 0;
-
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* p = squares[r][c];
-            if (!p) continue;
-            if (p->getColor() == Color::White) {
-                if (p->getType() != PieceType::King) whitePieces++;
-                if (p->getType() == PieceType::Knight || p->getType() == PieceType::Bishop) {
-                    whiteMinor++;
-                }
-            } else {
-                if (p->getType() != PieceType::King) blackPieces++;
-                if (p->getType() == PieceType::Knight || p->getType() == PieceType::Bishop) {
-                    blackMinor++;
-                }
-            }
-        }
-    }
+    const int W = static_cast<int>(Color::White);
+    const int B = static_cast<int>(Color::Black);
+    const int king = static_cast<int>(PieceType::King);
+    const int knight = static_cast<int>(PieceType::Knight);
+    const int bishop = static_cast<int>(PieceType::Bishop);
+
+    int whitePieces = popCount(colorBB[W] & ~pieceBB[W][king]);
+    int blackPieces = popCount(colorBB[B] & ~pieceBB[B][king]);
+    int whiteMinor = popCount(pieceBB[W][knight] | pieceBB[W][bishop]);
+    int blackMinor = popCount(pieceBB[B][knight] | pieceBB[B][bishop]);
 
     // King vs King
     if (whitePieces == 0 && blackPieces == 0) return true;
@@ -499,84 +1005,68 @@ bool Board::isDraw() {
 }
 
 void Board::getKingPosition(Color color, int& row, int& col) const {
-    if (color == Color::White) {
-        row = whiteKingRow;
-        col = whiteKingCol;
-    } else {
-        row = blackKingRow;
-        col = blackKingCol;
-    }
+    int sq = kingSquare[static_cast<int>(color)];
+    row = rowOf(sq);
+    col = colOf(sq);
 }
 
 bool Board::canCastleKingside(Color color) const {
     if (color == Color::White) {
-        return whiteCanCastleKingside;
+        return (castlingRights & WhiteKingside) != 0;
     } else {
-        return blackCanCastleKingside;
+        return (castlingRights & BlackKingside) != 0;
     }
 }
 
 bool Board::canCastleQueenside(Color color) const {
     if (color == Color::White) {
-        return whiteCanCastleQueenside;
+        return (castlingRights & WhiteQueenside) != 0;
     } else {
-        return blackCanCastleQueenside;
+        return (castlingRights & BlackQueenside) != 0;
     }
 }
 
 bool Board::canEnPassant(int pawnRow, int pawnCol, int targetCol) const {
-    if (!lastMove.isValid()) return false;
-    if (lastMove.type != MoveType::DoublePawnPush) return false;
+    if (enPassantSquare < 0) return false;
 
-    Piece* lastMovedPiece = getPiece(lastMove.toRow, lastMove.toCol);
-    if (!lastMovedPiece || lastMovedPiece->getType() != PieceType::Pawn) return false;
+    Color color = getPieceColorAt(square(pawnRow, pawnCol));
+    if (color == Color::None) return false;
 
-    // Check if the target column matches the last pawn's column
-    if (lastMove.toCol != targetCol) return false;
-
-    // Check if pawns are adjacent
-    if (lastMove.toRow != pawnRow) return false;
-    if (std::abs(lastMove.toCol - pawnCol) != 1) return false;
+    // The capturing pawn must stand next to the pawn that just double-stepped
+    int direction = (color == Color::White) ? -1 : 1;
+    if (!Piece::isValidSquare(pawnRow + direction, targetCol)) return false;
+    if (square(pawnRow + direction, targetCol) != enPassantSquare) return false;
+    if (std::abs(targetCol - pawnCol) != 1) return false;
 
     return true;
 }
 
 bool Board::isEmpty(int row, int col) const {
-    return getPiece(row, col) == nullptr;
+    if (!Piece::isValidSquare(row, col)) return true;
+    return mailbox[square(row, col)] == NoPiece;
 }
 
 bool Board::isEnemyPiece(int row, int col, Color myColor) const {
-    Piece* p = getPiece(row, col);
-    return p && p->getColor() != myColor;
+    if (!Piece::isValidSquare(row, col)) return false;
+    uint8_t code = mailbox[square(row, col)];
+    return code != NoPiece && codeColor(code) != myColor;
 }
 
 bool Board::isFriendlyPiece(int row, int col, Color myColor) const {
-    Piece* p = getPiece(row, col);
-    return p && p->getColor() == myColor;
+    if (!Piece::isValidSquare(row, col)) return false;
+    uint8_t code = mailbox[square(row, col)];
+    return code != NoPiece && codeColor(code) == myColor;
 }
 
 int Board::countPieces(Color color) const {
-    int count = 0;
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* p = squares[r][c];
-            if (p && p->getColor() == color) {
-                count++;
-            }
-        }
-    }
-    return count;
+    return popCount(colorBB[static_cast<int>(color)]);
 }
 
 int Board::getMaterialValue(Color color) const {
     int value = 0;
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece* p = squares[r][c];
-            if (p && p->getColor() == color) {
-                value += p->getValue();
-            }
-        }
+    for (int t = 0; t < 6; ++t) {
+        value += popCount(pieceBB[static_cast<int>(color)][t]) *
+                 Piece::pieceValue(static_cast<PieceType>(t));
     }
     return value;
 }
@@ -2,73 +2,193 @@
 
 #include "Piece.h"
 #include "Move.h"
-#include <vector>
-#include <memory>
+#include "MoveList.h"
+#include "Bitboard.h"
+#include <cstdint>
+#include <string>
+
+// Castling rights bitmask
+enum CastlingRight : uint8_t {
+    WhiteKingside  = 1,
+    WhiteQueenside = 2,
+    BlackKingside  = 4,
+    BlackQueenside = 8,
+    AllCastling    = 15
+};
+
+// Move subsets produced by Board::getLegalMoves. Captures also holds
+// promotions and en passant, so Captures + Quiets == All.
+enum class MoveGen {
+    All,
+    Captures,
+    Quiets
+};
+
+// Check and attack information derived from the piece placement. Board
+// computes it on first use after a change and keeps it until pieces move.
+struct AttackCache {
+    Bitboard checkers[2];      // Enemy pieces attacking each side's king
+    Bitboard kingBlockers[2];  // Lone pieces (either color) between each king and an enemy slider
+    Bitboard attacked[2];      // Squares attacked by each side
+    uint8_t valid;             // Bits: CheckInfoValid << color, AttacksValid << color
+};
 
+// State needed to take back a move made with Board::makeMove(move, undo).
+// Search code keeps one record per ply on its own stack.
+struct UndoInfo {
+    AttackCache attackCache;
+    uint64_t hashKey;
+    Move lastMove;
+    PieceType capturedPiece;
+    uint8_t castlingRights;
+    int8_t enPassantSquare;
+    int8_t kingSquare[2];
+};
+
+// Note: the attack cache is filled in from const methods, so a single Board
+// must not be queried from several threads at once (copies are fine).
 class Board {
+public:
+    enum : uint8_t { CheckInfoValid = 1, AttacksValid = 4 };
+
 private:
-    Piece* squares[8][8];
+    // Bitboards indexed by [color][piece type]
+    Bitboard pieceBB[2][6];
+    Bitboard colorBB[2];
+    Bitboard occupiedBB;
+
+    // Compact mailbox: one piece code per square (see makePieceCode)
+    uint8_t mailbox[64];
+
     Color currentTurn;
     Move lastMove;
 
-    // Castling rights
-    bool whiteCanCastleKingside;
-    bool whiteCanCastleQueenside;
-    bool blackCanCastleKingside;
-    bool blackCanCastleQueenside;
+    uint8_t castlingRights;
+    int8_t enPassantSquare;   // Square a pawn may capture onto, or -1
+
+    // King squares for quick access
+    int8_t kingSquare[2];
+
+    // Zobrist key of the position, updated incrementally
+    uint64_t hashKey;
+
+    // Material plus piece-square values per color and the game phase,
+    // updated incrementally (see PieceSquareTables.h)
+    int midgameScore[2];
+    int endgameScore[2];
+    int phase;
 
-    // King positions for quick access
-    int whiteKingRow, whiteKingCol;
-    int blackKingRow, blackKingCol;
+    mutable AttackCache attackCache;
+
+    static constexpr uint8_t NoPiece = 12;
+    static uint8_t makePieceCode(PieceType type, Color color) {
+        return static_cast<uint8_t>(static_cast<int>(color) * 6 + static_cast<int>(type));
+    }
+    static PieceType codeType(uint8_t code) { return static_cast<PieceType>(code % 6); }
+    static Color codeColor(uint8_t code) { return static_cast<Color>(code / 6); }
 
     void clearBoard();
-    void updateKingPosition(Color color, int row, int col);
-    void updateCastlingRights(const Move& move, Piece* movedPiece);
+    void putPiece(int sq, PieceType type, Color color);
+    void removePieceAt(int sq);
+    void movePieceBB(int from, int to);
+    uint64_t enPassantKey() const;
+    void verifyHashKey() const;
+
+    // Attack cache
+    const AttackCache& checkInfo(Color color) const;
+    const AttackCache& attackInfo(Color color) const;
+    Bitboard computeKingBlockers(Color color) const;
+    Bitboard computeAttacks(Color color) const;
+
+    // Legal move generation helpers
+    void addPawnMoves(Color color, Bitboard targetMask, Bitboard pinned, MoveGen gen,
+                      MoveList& moves) const;
+    bool isLegalEnPassant(Color color, int from, int to) const;
+    bool isCastlingLegal(Color color, bool kingside) const;
 
 public:
     Board();
-    Board(const Board& other);
-    Board& operator=(const Board& other);
-    ~Board();
 
     void setupInitialPosition();
 
+    // FEN import/export. Move counters are accepted but not tracked.
+    bool loadFEN(const std::string& fen);
+    std::string toFEN() const;
+
     // Piece access
-    Piece* getPiece(int row, int col) const;
-    void setPiece(int row, int col, Piece* piece);
+    const Piece* getPiece(int row, int col) const;
+    void setPiece(int row, int col, PieceType type, Color color);
     void removePiece(int row, int col);
 
+    // Bitboard access
+    Bitboard getPieces(Color color, PieceType type) const {
+        return pieceBB[static_cast<int>(color)][static_cast<int>(type)];
+    }
+    Bitboard getPieces(Color color) const { return colorBB[static_cast<int>(color)]; }
+    Bitboard getOccupied() const { return occupiedBB; }
+    PieceType getPieceTypeAt(int sq) const {
+        return mailbox[sq] == NoPiece ? PieceType::None : codeType(mailbox[sq]);
+    }
+    Color getPieceColorAt(int sq) const {
+        return mailbox[sq] == NoPiece ? Color::None : codeColor(mailbox[sq]);
+    }
+
     // Move handling
     bool makeMove(const Move& move);
-    void undoMove(const Move& move, Piece* capturedPiece, bool wasFirstMove);
+    bool makeMove(const Move& move, UndoInfo& undo);
+    void undoMove(const Move& move, const UndoInfo& undo);
+
+    // Pass the turn without moving (null move pruning in the search)
+    void makeNullMove(UndoInfo& undo);
+    void undoNullMove(const UndoInfo& undo);
 
     // Move generation
-    std::vector<Move> getPseudoLegalMoves(Color color) const;
-    std::vector<Move> getLegalMoves(Color color);
-    std::vector<Move> getLegalMovesForPiece(int row, int col);
+    void getPseudoLegalMoves(Color color, MoveList& moves) const;
+    void getLegalMoves(Color color, MoveList& moves, MoveGen gen = MoveGen::All) const;
+    MoveList getLegalMoves(Color color) const;
+    MoveList getLegalMovesForPiece(int row, int col) const;
+
+    // True if move is one getLegalMoves(color) would produce. Used to check
+    // moves remembered from other positions (hash and killer moves).
+    bool isLegalMove(Color color, const Move& move) const;
 
     // Game state
     Color getCurrentTurn() const { return currentTurn; }
-    void setCurrentTurn(Color turn) { currentTurn = turn; }
+    void setCurrentTurn(Color turn);
     void switchTurn();
     Move getLastMove() const { return lastMove; }
 
-    // Check detection
+    // Position hashing
+    uint64_t getHashKey() const { return hashKey; }
+    uint64_t computeHashKey() const;  // From scratch, for verification
+
+    // Check detection. Checkers, pins and attacked squares come from the
+    // attack cache; attackersTo always computes from scratch.
+    Bitboard attackersTo(int sq, Bitboard occupied) const;
+    Bitboard getCheckers(Color color) const { return checkInfo(color).checkers[static_cast<int>(color)]; }
+    Bitboard getPinned(Color color) const;
+    Bitboard getAttackedSquares(Color byColor) const {
+        return attackInfo(byColor).attacked[static_cast<int>(byColor)];
+    }
     bool isSquareAttacked(int row, int col, Color byColor) const;
     bool isInCheck(Color color) const;
-    bool isCheckmate(Color color);
-    bool isStalemate(Color color);
+    bool givesCheck(const Move& move) const;
+    bool isCheckmate(Color color) const;
+    bool isStalemate(Color color) const;
     bool isDraw();
 
     // King position
     void getKingPosition(Color color, int& row, int& col) const;
+    int getKingSquare(Color color) const { return kingSquare[static_cast<int>(color)]; }
 
     // Castling
     bool canCastleKingside(Color color) const;
     bool canCastleQueenside(Color color) const;
+    uint8_t getCastlingRights() const { return castlingRights; }
 
     // En passant
     bool canEnPassant(int pawnRow, int pawnCol, int targetCol) const;
+    int getEnPassantSquare() const { return enPassantSquare; }
 
     // Utility
     bool isEmpty(int row, int col) const;
@@ -76,6 +196,14 @@ public:
     bool isFriendlyPiece(int row, int col, Color myColor) const;
 
     // Evaluation helpers
+    int getMidgameScore(Color color) const { return midgameScore[static_cast<int>(color)]; }
+    int getEndgameScore(Color color) const { return endgameScore[static_cast<int>(color)]; }
+    int getPhase() const { return phase; }  // Can exceed MaxPhase after promotions
+    bool hasNonPawnMaterial(Color color) const {
+        int c = static_cast<int>(color);
+        return (colorBB[c] & ~pieceBB[c][static_cast<int>(PieceType::Pawn)] &
+                ~pieceBB[c][static_cast<int>(PieceType::King)]) != 0;
+    }
     int countPieces(Color color) const;
     int getMaterialValue(Color color) const;
 };
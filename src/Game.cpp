@@ -1,14 +1,31 @@
 #include "Game.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <string>
 #include <thread>
 
+namespace {
+
+// Leave a core for the window and the renderer, and keep the default small
+int defaultAIThreads() {
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores - 1, 1, 4);
+}
+
+} // namespace
+
 Game::Game()
-    : state(GameState::PlayerTurn),
+    : aiCancel(false),
+      aiProgressDepth(0),
+      aiProgressNodes(0),
+      state(GameState::PlayerTurn),
       playerColor(Color::White),
       aiColor(Color::Black),
       selectedRow(-1),
       selectedCol(-1),
-      promotionColumn(-1) {
+      promotionColumn(-1),
+      verbose(false) {
 
     window.create(sf::VideoMode({720, 750}), "Chess Titans", sf::Style::Titlebar | sf::Style::Close);
     window.setFramerateLimit(60);
@@ -16,9 +33,18 @@ Game::Game()
     renderer = std::make_unique<Renderer>(window, 80);
     board.setupInitialPosition();
     ai = std::make_unique<AI>(aiColor, 4);
+    ai->setThreads(defaultAIThreads());
+    ai->setIterationCallback([this](const SearchStats& stats) {
+        aiProgressDepth = stats.depth;
+        aiProgressNodes = stats.nodes;
+    });
     renderer->loadFont("C:/Windows/Fonts/seguisym.ttf");
 }
 
+Game::~Game() {
+    cancelAIMove();
+}
+
 void Game::run() {
     while (window.isOpen()) {
         handleEvents();
@@ -30,6 +56,7 @@ void Game::run() {
 void Game::handleEvents() {
     while (const std::optional event = window.pollEvent()) {
         if (event->is<sf::Event::Closed>()) {
+            cancelAIMove();
             window.close();
         }
 
@@ -49,11 +76,7 @@ void Game::handleEvents() {
                 deselectPiece();
             }
             if (keyEvent->code == sf::Keyboard::Key::R) {
-                // Restart game
-                board.setupInitialPosition();
-                state = GameState::PlayerTurn;
-                deselectPiece();
-                lastMove = Move();
+                restart();
             }
         }
     }
@@ -66,7 +89,7 @@ void Game::handleMouseClick(int x, int y) {
         return;
     }
 
-    Piece* clickedPiece = board.getPiece(row, col);
+    const Piece* clickedPiece = board.getPiece(row, col);
 
     // If no piece is selected
     if (selectedRow < 0) {
@@ -107,7 +130,7 @@ void Game::handlePromotion(int x, int y) {
     if (relativeRow >= 0 && relativeRow < 4) {
         PieceType promotionTypes[] = {PieceType::Queen, PieceType::Rook,
                                        PieceType::Bishop, PieceType::Knight};
-        pendingPromotionMove.promotionPiece = promotionTypes[relativeRow];
+        pendingPromotionMove.setPromotionPiece(promotionTypes[relativeRow]);
 
         // Make the promotion move
         board.makeMove(pendingPromotionMove);
@@ -137,7 +160,7 @@ void Game::deselectPiece() {
 void Game::tryMove(int row, int col) {
     // Find a matching legal move
     for (const auto& move : currentLegalMoves) {
-        if (move.toRow == row && move.toCol == col) {
+        if (move.toRow() == row && move.toCol() == col) {
             // Check if it's a promotion move
             if (move.isPromotion()) {
                 pendingPromotionMove = move;
@@ -166,8 +189,39 @@ void Game::makePlayerMove(const Move& move) {
     }
 }
 
-void Game::makeAIMove() {
-    Move aiMove = ai->getBestMove(board);
+void Game::startAIMove() {
+    aiCancel = false;
+    aiProgressDepth = 0;
+    aiProgressNodes = 0;
+
+    SearchLimits limits = ai->getSearchLimits();
+    limits.stop = &aiCancel;
+    aiResult = std::async(std::launch::async, [this, limits, searchBoard = board]() mutable {
+        return ai->getBestMove(searchBoard, limits);
+    });
+}
+
+void Game::cancelAIMove() {
+    if (!aiResult.valid()) return;
+
+    // The search stops within a few nodes; its move is thrown away
+    aiCancel = true;
+    aiResult.get();
+}
+
+void Game::restart() {
+    cancelAIMove();
+    board.setupInitialPosition();
+    state = GameState::PlayerTurn;
+    deselectPiece();
+    lastMove = Move();
+}
+
+void Game::finishAIMove() {
+    Move aiMove = aiResult.get();
+    if (verbose) {
+        std::cout << ai->getLastSearchStats().toString() << std::endl;
+    }
 
     if (aiMove.isValid()) {
         board.makeMove(aiMove);
@@ -200,8 +254,14 @@ std::string Game::getStatusText() const {
             }
             return "Your turn (White)";
 
-        case GameState::AIThinking:
-            return "Computer is thinking...";
+        case GameState::AIThinking: {
+            int depth = aiProgressDepth;
+            if (depth == 0) {
+                return "Computer is thinking...";
+            }
+            return "Computer is thinking... (depth " + std::to_string(depth) + ", " +
+                   std::to_string(aiProgressNodes / 1000) + "k nodes)";
+        }
 
         case GameState::Promotion:
             return "Select promotion piece";
@@ -225,9 +285,14 @@ std::string Game::getStatusText() const {
 }
 
 void Game::update() {
-    if (state == GameState::AIThinking) {
-        // Make AI move (in a real game, this might be threaded)
-        makeAIMove();
+    if (state != GameState::AIThinking) return;
+
+    // Start the search, then poll it once per frame so the window stays
+    // responsive while the computer thinks
+    if (!aiResult.valid()) {
+        startAIMove();
+    } else if (aiResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        finishAIMove();
     }
 }
 
@@ -4,6 +4,9 @@
 #include "Board.h"
 #include "Renderer.h"
 #include "AI.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
 #include <memory>
 
 enum class GameState {
@@ -22,6 +25,13 @@ private:
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<AI> ai;
 
+    // The AI searches a copy of the board on a worker thread while the
+    // window keeps running; aiCancel stops it early (restart, close)
+    std::future<Move> aiResult;
+    std::atomic<bool> aiCancel;
+    std::atomic<int> aiProgressDepth;
+    std::atomic<uint64_t> aiProgressNodes;
+
     GameState state;
     Color playerColor;
     Color aiColor;
@@ -29,7 +39,7 @@ private:
     // Selection state
     int selectedRow;
     int selectedCol;
-    std::vector<Move> currentLegalMoves;
+    MoveList currentLegalMoves;
 
     // Promotion state
     Move pendingPromotionMove;
@@ -38,6 +48,9 @@ private:
     // Move history
     Move lastMove;
 
+    // Print the search statistics after every AI move
+    bool verbose;
+
     void handleEvents();
     void handleMouseClick(int x, int y);
     void handlePromotion(int x, int y);
@@ -47,7 +60,10 @@ private:
     void tryMove(int row, int col);
 
     void makePlayerMove(const Move& move);
-    void makeAIMove();
+    void startAIMove();
+    void finishAIMove();
+    void cancelAIMove();
+    void restart();
 
     void checkGameEnd();
     std::string getStatusText() const;
@@ -57,6 +73,13 @@ private:
 
 public:
     Game();
+    ~Game();
 
     void run();
+
+    // Search threads for the AI (1: single-threaded). Defaults to one less
+    // than the number of cores, at most 4.
+    void setAIThreads(int threads) { ai->setThreads(threads); }
+
+    void setVerbose(bool enabled) { verbose = enabled; }
 };
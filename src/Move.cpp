@@ -1,39 +1,22 @@
 #include "Move.h"
-#include "Piece.h"
 
-Move::Move()
-    : fromRow(-1), fromCol(-1), toRow(-1), toCol(-1),
-      type(MoveType::Normal), promotionPiece(PieceType::Queen) {}
-
-Move::Move(int fr, int fc, int tr, int tc, MoveType t)
-    : fromRow(fr), fromCol(fc), toRow(tr), toCol(tc),
-      type(t), promotionPiece(PieceType::Queen) {}
-
-bool Move::operator==(const Move& other) const {
-    return fromRow == other.fromRow && fromCol == other.fromCol &&
-           toRow == other.toRow && toCol == other.toCol &&
-           type == other.type;
-}
-
-bool Move::operator!=(const Move& other) const {
-    return !(*this == other);
-}
-
-bool Move::isValid() const {
-    return fromRow >= 0 && fromRow < 8 && fromCol >= 0 && fromCol < 8 &&
-           toRow >= 0 && toRow < 8 && toCol >= 0 && toCol < 8;
-}
-
-bool Move::isCapture() const {
-    return type == MoveType::Capture ||
-           type == MoveType::EnPassant ||
-           type == MoveType::PromotionCapture;
-}
-
-bool Move::isPromotion() const {
-    return type == MoveType::Promotion || type == MoveType::PromotionCapture;
-}
-
-bool Move::isCastle() const {
-    return type == MoveType::CastleKingside || type == MoveType::CastleQueenside;
+std::string Move::toString() const {
+    if (!isValid()) return "0000";
+
+    std::string s;
+    s += static_cast<char>('a' + fromCol());
+    s += static_cast<char>('8' - fromRow());
+    s += static_cast<char>('a' + toCol());
+    s += static_cast<char>('8' - toRow());
+
+    if (isPromotion()) {
+        switch (promotionPiece()) {
+            case PieceType::Knight: s += 'n'; break;
+            case PieceType::Bishop: s += 'b'; break;
+            case PieceType::Rook:   s += 'r'; break;
+            default:                s += 'q'; break;
+        }
+    }
+
+    return s;
 }
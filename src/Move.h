@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Piece.h"
 #include <cstdint>
+#include <string>
 
 enum class MoveType {
     Normal,
@@ -13,22 +15,117 @@ enum class MoveType {
     PromotionCapture
 };
 
-enum class PieceType;
-
+// A move packed into 16 bits:
+//   bits 0-5   from square (row * 8 + col)
+//   bits 6-11  to square
+//   bits 12-15 flags (move type and promotion piece, see Flag)
+// The row/col constructor and accessors convert to and from the board
+// coordinates used by Game, Renderer and the WASM bridge.
 struct Move {
-    int fromRow, fromCol;
-    int toRow, toCol;
-    MoveType type;
-    PieceType promotionPiece;
+    enum Flag : uint16_t {
+        QuietFlag        = 0,
+        DoublePushFlag   = 1,
+        KingCastleFlag   = 2,
+        QueenCastleFlag  = 3,
+        CaptureFlag      = 4,
+        EnPassantFlag    = 5,
+        PromotionFlag    = 8,   // + promotion index (Knight, Bishop, Rook, Queen)
+        PromoCaptureFlag = 12   // + promotion index
+    };
+
+    uint16_t data;
+
+    Move() : data(0) {}
+    Move(int from, int to, MoveType t, PieceType promotion = PieceType::Queen)
+        : data(static_cast<uint16_t>(from | (to << 6) | (encodeFlags(t, promotion) << 12))) {}
+    Move(int fr, int fc, int tr, int tc, MoveType t = MoveType::Normal,
+         PieceType promotion = PieceType::Queen)
+        : Move(fr * 8 + fc, tr * 8 + tc, t, promotion) {}
+
+    static Move fromRaw(uint16_t raw) {
+        Move m;
+        m.data = raw;
+        return m;
+    }
+    uint16_t raw() const { return data; }
+
+    // Square form
+    int from() const { return data & 0x3F; }
+    int to() const { return (data >> 6) & 0x3F; }
+    int flags() const { return data >> 12; }
+
+    // Row/col form
+    int fromRow() const { return from() >> 3; }
+    int fromCol() const { return from() & 7; }
+    int toRow() const { return to() >> 3; }
+    int toCol() const { return to() & 7; }
+
+    MoveType type() const;
+    PieceType promotionPiece() const;
+    void setPromotionPiece(PieceType piece);
 
-    Move();
-    Move(int fr, int fc, int tr, int tc, MoveType t = MoveType::Normal);
+    bool operator==(const Move& other) const { return data == other.data; }
+    bool operator!=(const Move& other) const { return data != other.data; }
 
-    bool operator==(const Move& other) const;
-    bool operator!=(const Move& other) const;
+    bool isValid() const { return from() != to(); }
+    bool isCapture() const {
+        return (flags() & CaptureFlag) != 0;
+    }
+    bool isPromotion() const { return (flags() & PromotionFlag) != 0; }
+    bool isCastle() const {
+        return flags() == KingCastleFlag || flags() == QueenCastleFlag;
+    }
 
-    bool isValid() const;
-    bool isCapture() const;
-    bool isPromotion() const;
-    bool isCastle() const;
+    // Coordinate notation, e.g. "e2e4" or "e7e8q"
+    std::string toString() const;
+
+private:
+    static uint16_t encodeFlags(MoveType t, PieceType promotion);
 };
+
+inline uint16_t Move::encodeFlags(MoveType t, PieceType promotion) {
+    int promoIndex;
+    switch (promotion) {
+        case PieceType::Knight: promoIndex = 0; break;
+        case PieceType::Bishop: promoIndex = 1; break;
+        case PieceType::Rook:   promoIndex = 2; break;
+        default:                promoIndex = 3; break;  // Queen
+    }
+
+    switch (t) {
+        case MoveType::Capture:          return CaptureFlag;
+        case MoveType::DoublePawnPush:   return DoublePushFlag;
+        case MoveType::EnPassant:        return EnPassantFlag;
+        case MoveType::CastleKingside:   return KingCastleFlag;
+        case MoveType::CastleQueenside:  return QueenCastleFlag;
+        case MoveType::Promotion:        return static_cast<uint16_t>(PromotionFlag + promoIndex);
+        case MoveType::PromotionCapture: return static_cast<uint16_t>(PromoCaptureFlag + promoIndex);
+        default:                         return QuietFlag;
+    }
+}
+
+inline MoveType Move::type() const {
+    static const MoveType types[16] = {
+        MoveType::Normal, MoveType::DoublePawnPush,
+        MoveType::CastleKingside, MoveType::CastleQueenside,
+        MoveType::Capture, MoveType::EnPassant,
+        MoveType::Normal, MoveType::Normal,
+        MoveType::Promotion, MoveType::Promotion,
+        MoveType::Promotion, MoveType::Promotion,
+        MoveType::PromotionCapture, MoveType::PromotionCapture,
+        MoveType::PromotionCapture, MoveType::PromotionCapture
+    };
+    return types[flags()];
+}
+
+inline PieceType Move::promotionPiece() const {
+    static const PieceType pieces[4] = {
+        PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen
+    };
+    return isPromotion() ? pieces[flags() & 3] : PieceType::Queen;
+}
+
+inline void Move::setPromotionPiece(PieceType piece) {
+    if (!isPromotion()) return;
+    data = static_cast<uint16_t>((data & 0x0FFF) | (encodeFlags(type(), piece) << 12));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Move.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// Fixed-capacity move container that lives on the stack. The move
+// generators append into it by reference, so generating moves never
+// touches the heap. 256 is above the 218-move maximum of any legal position.
+class MoveList {
+public:
+    static constexpr size_t Capacity = 256;
+
+    MoveList() : count(0) {}
+
+    void push_back(const Move& move) { new (data() + count++) Move(move); }
+    void clear() { count = 0; }
+    void resize(size_t n) { count = n; }  // Shrink only
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](size_t i) { return data()[i]; }
+    const Move& operator[](size_t i) const { return data()[i]; }
+
+    Move* begin() { return data(); }
+    Move* end() { return data() + count; }
+    const Move* begin() const { return data(); }
+    const Move* end() const { return data() + count; }
+
+private:
+    static_assert(std::is_trivially_copyable<Move>::value &&
+                  std::is_trivially_destructible<Move>::value,
+                  "MoveList stores moves in raw storage");
+
+    // Raw storage so constructing a list does not initialize 256 moves
+    alignas(Move) unsigned char storage[Capacity * sizeof(Move)];
+    size_t count;
+
+    Move* data() { return reinterpret_cast<Move*>(storage); }
+    const Move* data() const { return reinterpret_cast<const Move*>(storage); }
+};
@@ -0,0 +1,209 @@
+#include "MovePicker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+void MoveHistory::clear() {
+    std::memset(butterfly, 0, sizeof(butterfly));
+    for (auto& row : counterMoves) {
+        for (Move& move : row) move = Move();
+    }
+}
+
+void MoveHistory::age() {
+    for (auto& side : butterfly) {
+        for (auto& row : side) {
+            for (int& entry : row) entry /= 2;
+        }
+    }
+}
+
+void MoveHistory::adjust(int& entry, int bonus) {
+    // Moves the entry towards +-MaxScore, more slowly the closer it gets,
+    // so scores stay bounded without periodic rescaling
+    entry += bonus - entry * std::abs(bonus) / MaxScore;
+}
+
+void MoveHistory::update(Color color, const Move& move, const Move& previous,
+                         const Move* tried, int triedCount, int depth) {
+    int bonus = std::min(depth * depth, MaxScore / 4);
+    auto& side = butterfly[static_cast<int>(color)];
+
+    adjust(side[move.from()][move.to()], bonus);
+    for (int i = 0; i < triedCount; ++i) {
+        adjust(side[tried[i].from()][tried[i].to()], -bonus);
+    }
+
+    if (previous.isValid()) {
+        counterMoves[previous.from()][previous.to()] = move;
+    }
+}
+
+MovePicker::MovePicker(const Board& b, Color c, Move hash, const Move* killerMoves, int count,
+                       const MoveHistory* moveHistory)
+    : board(b), color(c), stage(Stage::HashMove), hashMove(hash), refutationCount(0),
+      history(moveHistory), capturesOnly(false), current(0), captureEnd(0),
+      badCaptureBegin(0) {
+    for (int i = 0; i < count; ++i) {
+        addRefutation(killerMoves[i]);
+    }
+    if (history) {
+        addRefutation(history->counterMove(board.getLastMove()));
+    }
+}
+
+MovePicker::MovePicker(const Board& b, Color c, bool inCheck)
+    : board(b), color(c), stage(Stage::GenerateCaptures), refutationCount(0),
+      history(nullptr), capturesOnly(!inCheck), current(0), captureEnd(0),
+      badCaptureBegin(0) {}
+
+void MovePicker::addRefutation(const Move& move) {
+    // Captures and promotions are already searched with the captures
+    if (refutationCount < MaxRefutations && move.isValid() && move != hashMove &&
+        !move.isCapture() && !move.isPromotion() && !isRefutation(move)) {
+        refutations[refutationCount++] = move;
+    }
+}
+
+void MovePicker::scoreCaptures() {
+    Bitboard enemies = board.getPieces(Piece::oppositeColor(color));
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        PieceType attacker = board.getPieceTypeAt(move.from());
+        PieceType victim = board.getPieceTypeAt(move.to());
+        if (move.type() == MoveType::EnPassant) victim = PieceType::Pawn;
+
+        // MVV-LVA: most valuable victim first, then least valuable attacker
+        int victimValue = Piece::pieceValue(victim);
+        int attackerValue = Piece::pieceValue(attacker);
+        int score = victimValue * 10 - attackerValue;
+
+        // Losing: a defended piece taken by a more valuable one (a king can
+        // only take undefended pieces). Underpromotions are almost never best.
+        bool good;
+        if (move.isPromotion()) {
+            good = move.promotionPiece() == PieceType::Queen;
+            score += Piece::pieceValue(move.promotionPiece()) * 10;
+        } else {
+            good = victimValue >= attackerValue ||
+                   !(board.attackersTo(move.to(), board.getOccupied()) & enemies);
+        }
+
+        scores[i] = good ? score + GoodCaptureScore : score;
+    }
+}
+
+void MovePicker::scoreQuiets() {
+    for (size_t i = captureEnd; i < moves.size(); ++i) {
+        scores[i] = history ? history->score(color, moves[i]) : 0;
+    }
+}
+
+size_t MovePicker::pickBest(size_t begin, size_t end) {
+    // Partial selection sort: only the move about to be searched is placed
+    size_t best = begin;
+    for (size_t i = begin + 1; i < end; ++i) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    std::swap(moves[begin], moves[best]);
+    std::swap(scores[begin], scores[best]);
+    return begin;
+}
+
+bool MovePicker::isRefutation(const Move& move) const {
+    for (int i = 0; i < refutationCount; ++i) {
+        if (refutations[i] == move) return true;
+    }
+    return false;
+}
+
+bool MovePicker::next(Move& move) {
+    switch (stage) {
+        case Stage::HashMove:
+            stage = Stage::GenerateCaptures;
+            if (hashMove.isValid() && board.isLegalMove(color, hashMove)) {
+                move = hashMove;
+                return true;
+            }
+            [[fallthrough]];
+
+        case Stage::GenerateCaptures:
+            board.getLegalMoves(color, moves, MoveGen::Captures);
+            scoreCaptures();
+            captureEnd = moves.size();
+            current = 0;
+            stage = Stage::GoodCaptures;
+            [[fallthrough]];
+
+        case Stage::GoodCaptures:
+            while (current < captureEnd) {
+                size_t i = pickBest(current, captureEnd);
+                if (scores[i] < GoodCaptureScore) break;  // Only bad captures are left
+                ++current;
+                if (moves[i] == hashMove) continue;
+                move = moves[i];
+                return true;
+            }
+            badCaptureBegin = current;
+            if (capturesOnly) {
+                stage = Stage::Done;
+                break;
+            }
+            current = 0;
+            stage = Stage::Killers;
+            [[fallthrough]];
+
+        case Stage::Killers:
+            while (current < static_cast<size_t>(refutationCount)) {
+                const Move& refutation = refutations[current++];
+                if (board.isLegalMove(color, refutation)) {
+                    move = refutation;
+                    return true;
+                }
+            }
+            stage = Stage::GenerateQuiets;
+            [[fallthrough]];
+
+        case Stage::GenerateQuiets: {
+            MoveList quiets;
+            board.getLegalMoves(color, quiets, MoveGen::Quiets);
+            moves.resize(captureEnd);
+            for (const Move& quiet : quiets) {
+                moves.push_back(quiet);
+            }
+            scoreQuiets();
+            current = captureEnd;
+            stage = Stage::Quiets;
+            [[fallthrough]];
+        }
+
+        case Stage::Quiets:
+            while (current < moves.size()) {
+                size_t i = history ? pickBest(current, moves.size()) : current;
+                ++current;
+                if (moves[i] == hashMove || isRefutation(moves[i])) continue;
+                move = moves[i];
+                return true;
+            }
+            current = badCaptureBegin;
+            stage = Stage::BadCaptures;
+            [[fallthrough]];
+
+        case Stage::BadCaptures:
+            while (current < captureEnd) {
+                size_t i = pickBest(current, captureEnd);
+                ++current;
+                if (moves[i] == hashMove) continue;
+                move = moves[i];
+                return true;
+            }
+            stage = Stage::Done;
+            [[fallthrough]];
+
+        case Stage::Done:
+            break;
+    }
+    return false;
+}
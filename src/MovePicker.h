@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Board.h"
+
+// Statistics on quiet moves gathered by the search: how often each from-to
+// pair caused a cutoff (butterfly history), and which quiet move last
+// refuted each move of the opponent (counter moves).
+class MoveHistory {
+public:
+    MoveHistory() { clear(); }
+
+    void clear();
+    void age();  // Halve the scores so that recent searches weigh more
+
+    int score(Color color, const Move& move) const {
+        return butterfly[static_cast<int>(color)][move.from()][move.to()];
+    }
+    Move counterMove(const Move& previous) const {
+        return previous.isValid() ? counterMoves[previous.from()][previous.to()] : Move();
+    }
+
+    // Quiet move caused a beta cutoff at depth after the quiet moves in
+    // tried had failed to; previous is the opponent's move before it
+    void update(Color color, const Move& move, const Move& previous,
+                const Move* tried, int triedCount, int depth);
+
+private:
+    static constexpr int MaxScore = 1 << 14;
+
+    int butterfly[2][64][64];
+    Move counterMoves[64][64];
+
+    static void adjust(int& entry, int bonus);
+};
+
+// Hands out the legal moves of a position one at a time for the search,
+// most promising first:
+//   1. hash move (the best move found for this position earlier)
+//   2. captures that do not lose material and queen promotions, by MVV-LVA
+//   3. killer moves (quiet moves that caused a cutoff at the same ply), then
+//      the counter move to the opponent's last move
+//   4. remaining quiet moves, by history score
+//   5. losing captures and underpromotions
+// Each group is generated only when the previous one runs out, so a node
+// that cuts off on a capture never generates its quiet moves.
+class MovePicker {
+public:
+    MovePicker(const Board& board, Color color, Move hashMove,
+               const Move* killers = nullptr, int killerCount = 0,
+               const MoveHistory* history = nullptr);
+
+    // Quiescence search: only group 2, or every move when in check
+    MovePicker(const Board& board, Color color, bool inCheck);
+
+    // Returns false once every legal move has been handed out
+    bool next(Move& move);
+
+private:
+    enum class Stage {
+        HashMove,
+        GenerateCaptures,
+        GoodCaptures,
+        Killers,
+        GenerateQuiets,
+        Quiets,
+        BadCaptures,
+        Done
+    };
+
+    static constexpr int MaxRefutations = 3;  // Two killers and a counter move
+    static constexpr int GoodCaptureScore = 1 << 20;
+
+    const Board& board;
+    Color color;
+    Stage stage;
+    Move hashMove;
+    Move refutations[MaxRefutations];
+    int refutationCount;
+    const MoveHistory* history;
+    bool capturesOnly;
+
+    // Captures are stored first, quiet moves are appended after them
+    MoveList moves;
+    int scores[MoveList::Capacity];
+    size_t current;
+    size_t captureEnd;
+    size_t badCaptureBegin;  // Captures before this index were searched as good
+
+    void addRefutation(const Move& move);
+    void scoreCaptures();
+    void scoreQuiets();
+    size_t pickBest(size_t begin, size_t end);
+    bool isRefutation(const Move& move) const;
+};
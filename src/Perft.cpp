@@ -0,0 +1,142 @@
+#include "Perft.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// Mixes the search depth into the position key so one table serves all depths
+uint64_t depthKey(uint64_t key, int depth) {
+    return key ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+}
+
+} // namespace
+
+Perft::Perft(int threads, size_t hashMB)
+    : threadCount(std::max(1, threads)), tableMask(0) {
+    if (hashMB > 0) {
+        // Round down to a power of two so the index is a simple mask
+        size_t entries = 1;
+        while (entries * 2 * sizeof(HashEntry) <= hashMB * 1024 * 1024) {
+            entries *= 2;
+        }
+        table.reset(new HashEntry[entries]);
+        for (size_t i = 0; i < entries; ++i) {
+            table[i].checkKey.store(0, std::memory_order_relaxed);
+            table[i].nodes.store(0, std::memory_order_relaxed);
+        }
+        tableMask = entries - 1;
+    }
+}
+
+Perft::~Perft() = default;
+
+bool Perft::probe(uint64_t key, uint64_t& nodes) const {
+    if (!table) return false;
+    const HashEntry& entry = table[key & tableMask];
+    uint64_t n = entry.nodes.load(std::memory_order_relaxed);
+    uint64_t check = entry.checkKey.load(std::memory_order_relaxed);
+
+    // A torn write from another thread fails the XOR check and reads as a miss
+    if ((check ^ n) != key) return false;
+    nodes = n;
+    return true;
+}
+
+void Perft::store(uint64_t key, uint64_t nodes) {
+    if (!table) return;
+    HashEntry& entry = table[key & tableMask];
+    entry.nodes.store(nodes, std::memory_order_relaxed);
+    entry.checkKey.store(key ^ nodes, std::memory_order_relaxed);
+}
+
+uint64_t Perft::count(Board& board, int depth) {
+    if (depth <= 0) return 1;
+
+    MoveList moves;
+    board.getLegalMoves(board.getCurrentTurn(), moves);
+
+    // Bulk counting: the last ply only needs the number of legal moves
+    if (depth == 1) return moves.size();
+
+    uint64_t key = depthKey(board.getHashKey(), depth);
+    uint64_t nodes = 0;
+    if (probe(key, nodes)) return nodes;
+
+    for (const Move& move : moves) {
+        UndoInfo undo;
+        board.makeMove(move, undo);
+        nodes += count(board, depth - 1);
+        board.undoMove(move, undo);
+    }
+
+    store(key, nodes);
+    return nodes;
+}
+
+PerftResult Perft::run(const Board& board, int depth) {
+    PerftResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    MoveList rootMoves = board.getLegalMoves(board.getCurrentTurn());
+    result.divide.resize(rootMoves.size());
+
+    // Workers pull root moves from a shared counter
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        Board local(board);
+        for (size_t i = next++; i < rootMoves.size(); i = next++) {
+            const Move& move = rootMoves[i];
+            UndoInfo undo;
+            local.makeMove(move, undo);
+            result.divide[i] = std::make_pair(move, count(local, depth - 1));
+            local.undoMove(move, undo);
+        }
+    };
+
+    if (depth <= 0) {
+        result.divide.clear();
+        result.nodes = 1;
+    } else {
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < threadCount; ++t) {
+            helpers.emplace_back(worker);
+        }
+        worker();
+        for (auto& helper : helpers) {
+            helper.join();
+        }
+
+        for (const auto& entry : result.divide) {
+            result.nodes += entry.second;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+const std::vector<PerftPosition>& Perft::referencePositions() {
+    // From the Chess Programming Wiki "Perft Results" page
+    static const std::vector<PerftPosition> positions = {
+        {"Initial position",
+         "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+         {1, 20, 400, 8902, 197281, 4865609, 119060324}},
+        {"Kiwipete",
+         "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+         {1, 48, 2039, 97862, 4085603, 193690690, 0}},
+        {"Position 3",
+         "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+         {1, 14, 191, 2812, 43238, 674624, 11030083}},
+        {"Position 4",
+         "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+         {1, 6, 264, 9467, 422333, 15833292, 706045033}},
+        {"Position 5",
+         "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+         {1, 44, 1486, 62379, 2103487, 89941194, 0}},
+        {"Position 6",
+         "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+         {1, 46, 2079, 89890, 3894594, 164075551, 0}},
+    };
+    return positions;
+}
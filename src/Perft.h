@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Board.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Per-root-move leaf counts plus timing for one perft run
+struct PerftResult {
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+    std::vector<std::pair<Move, uint64_t>> divide;
+
+    double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+};
+
+// Standard test position with its known leaf counts (0 = not listed)
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    uint64_t expected[7];  // Index = depth
+};
+
+// Move generator test and benchmark: counts the leaves of the legal move
+// tree. Root moves can be split across threads, and subtree counts can be
+// memoized by position key in a shared table.
+class Perft {
+public:
+    explicit Perft(int threads = 1, size_t hashMB = 0);
+    ~Perft();
+
+    // Single-threaded leaf count
+    uint64_t count(Board& board, int depth);
+
+    // Counts every root move separately (divide) and times the run
+    PerftResult run(const Board& board, int depth);
+
+    static const std::vector<PerftPosition>& referencePositions();
+
+private:
+    struct HashEntry {
+        std::atomic<uint64_t> checkKey;  // Position key ^ depth ^ nodes
+        std::atomic<uint64_t> nodes;
+    };
+
+    int threadCount;
+    std::unique_ptr<HashEntry[]> table;
+    uint64_t tableMask;
+
+    bool probe(uint64_t key, uint64_t& nodes) const;
+    void store(uint64_t key, uint64_t nodes);
+};
@@ -1,8 +1,19 @@
 #include "Piece.h"
 #include "Move.h"
+#include "MoveList.h"
+#include "Board.h"
 
 Piece::Piece(PieceType t, Color c, int r, int co)
-    : type(t), color(c), row(r), col(co), hasMoved(false) {}
+    : type(t), color(c), row(r), col(co) {}
+
+void Piece::addTargetMoves(const Board& board, uint64_t targets, MoveList& moves) const {
+    int from = Bitboards::square(row, col);
+    while (targets) {
+        int to = Bitboards::popLsb(targets);
+        MoveType moveType = board.getPieceTypeAt(to) == PieceType::None ? MoveType::Normal : MoveType::Capture;
+        moves.push_back(Move(from, to, moveType));
+    }
+}
 
 wchar_t Piece::getSymbol() const {
     if (color == Color::White) {
@@ -29,7 +40,11 @@ wchar_t Piece::getSymbol() const {
 }
 
 int Piece::getValue() const {
-    switch (type) {
+    return pieceValue(type);
+}
+
+int Piece::pieceValue(PieceType pieceType) {
+    switch (pieceType) {
         case PieceType::Pawn:   return 100;
         case PieceType::Knight: return 320;
         case PieceType::Bishop: return 330;
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <vector>
 #include <string>
+#include <cstdint>
 
 enum class PieceType {
     King,
@@ -20,34 +20,35 @@ enum class Color {
 };
 
 class Board;
-struct Move;
+class MoveList;
 
+// Pieces are immutable views handed out by Board::getPiece(); the board
+// itself stores bitboards and a mailbox, so there is one shared instance
+// per (type, color, square).
 class Piece {
 protected:
     PieceType type;
     Color color;
     int row, col;
-    bool hasMoved;
+
+    // Adds a Normal or Capture move to every square in targets
+    void addTargetMoves(const Board& board, uint64_t targets, MoveList& moves) const;
 
 public:
     Piece(PieceType t, Color c, int r, int co);
     virtual ~Piece() = default;
 
-    virtual std::vector<Move> getPseudoLegalMoves(const Board& board) const = 0;
-    virtual Piece* clone() const = 0;
+    virtual void getPseudoLegalMoves(const Board& board, MoveList& moves) const = 0;
 
     PieceType getType() const { return type; }
     Color getColor() const { return color; }
     int getRow() const { return row; }
     int getCol() const { return col; }
-    bool getHasMoved() const { return hasMoved; }
-
-    void setPosition(int r, int c) { row = r; col = c; }
-    void setHasMoved(bool moved) { hasMoved = moved; }
 
     wchar_t getSymbol() const;
     int getValue() const;
 
+    static int pieceValue(PieceType pieceType);
     static Color oppositeColor(Color c);
     static bool isValidSquare(int r, int c);
 };
@@ -0,0 +1,121 @@
+#include "PieceSquareTables.h"
+#include "Piece.h"
+
+namespace PieceSquare {
+
+int midgame[2][6][64];
+int endgame[2][6][64];
+
+namespace {
+
+// Piece-Square Tables (from white's perspective, mirrored for black)
+// Values encourage good piece placement
+
+
+const int pawnTable[8][8] = {
+    {  0,   0,   0,   0,   0,   0,   0,   0},
+    { 50,  50,  50,  50,  50,  50,  50,  50},
+    { 10,  10,  20,  30,  30,  20,  10,  10},
+    {  5,   5,  10,  25,  25,  10,   5,   5},
+    {  0,   0,   0,  20,  20,   0,   0,   0},
+    {  5,  -5, -10,   0,   0, -10,  -5,   5},
+    {  5,  10,  10, -20, -20,  10,  10,   5},
+    {  0,   0,   0,   0,   0,   0,   0,   0}
+};
+
+const int knightTable[8][8] = {
+    {-50, -40, -30, -30, -30, -30, -40, -50},
+    {-40, -20,   0,   0,   0,   0, -20, -40},
+    {-30,   0,  10,  15,  15,  10,   0, -30},
+    {-30,   5,  15,  20,  20,  15,   5, -30},
+    {-30,   0,  15,  20,  20,  15,   0, -30},
+    {-30,   5,  10,  15,  15,  10,   5, -30},
+    {-40, -20,   0,   5,   5,   0, -20, -40},
+    {-50, -40, -30, -30, -30, -30, -40, -50}
+};
+
+const int bishopTable[8][8] = {
+    {-20, -10, -10, -10, -10, -10, -10, -20},
+    {-10,   0,   0,   0,   0,   0,   0, -10},
+    {-10,   0,   5,  10,  10,   5,   0, -10},
+    {-10,   5,   5,  10,  10,   5,   5, -10},
+    {-10,   0,  10,  10,  10,  10,   0, -10},
+    {-10,  10,  10,  10,  10,  10,  10, -10},
+    {-10,   5,   0,   0,   0,   0,   5, -10},
+    {-20, -10, -10, -10, -10, -10, -10, -20}
+};
+
+const int rookTable[8][8] = {
+    {  0,   0,   0,   0,   0,   0,   0,   0},
+    {  5,  10,  10,  10,  10,  10,  10,   5},
+    { -5,   0,   0,   0,   0,   0,   0,  -5},
+    { -5,   0,   0,   0,   0,   0,   0,  -5},
+    { -5,   0,   0,   0,   0,   0,   0,  -5},
+    { -5,   0,   0,   0,   0,   0,   0,  -5},
+    { -5,   0,   0,   0,   0,   0,   0,  -5},
+    {  0,   0,   0,   5,   5,   0,   0,   0}
+};
+
+const int queenTable[8][8] = {
+    {-20, -10, -10,  -5,  -5, -10, -10, -20},
+    {-10,   0,   0,   0,   0,   0,   0, -10},
+    {-10,   0,   5,   5,   5,   5,   0, -10},
+    { -5,   0,   5,   5,   5,   5,   0,  -5},
+    {  0,   0,   5,   5,   5,   5,   0,  -5},
+    {-10,   5,   5,   5,   5,   5,   0, -10},
+    {-10,   0,   5,   0,   0,   0,   0, -10},
+    {-20, -10, -10,  -5,  -5, -10, -10, -20}
+};
+
+const int kingMiddleGameTable[8][8] = {
+    {-30, -40, -40, -50, -50, -40, -40, -30},
+    {-30, -40, -40, -50, -50, -40, -40, -30},
+    {-30, -40, -40, -50, -50, -40, -40, -30},
+    {-30, -40, -40, -50, -50, -40, -40, -30},
+    {-20, -30, -30, -40, -40, -30, -30, -20},
+    {-10, -20, -20, -20, -20, -20, -20, -10},
+    { 20,  20,   0,   0,   0,   0,  20,  20},
+    { 20,  30,  10,   0,   0,  10,  30,  20}
+};
+
+const int kingEndGameTable[8][8] = {
+    {-50, -40, -30, -20, -20, -30, -40, -50},
+    {-30, -20, -10,   0,   0, -10, -20, -30},
+    {-30, -10,  20,  30,  30,  20, -10, -30},
+    {-30, -10,  30,  40,  40,  30, -10, -30},
+    {-30, -10,  30,  40,  40,  30, -10, -30},
+    {-30, -10,  20,  30,  30,  20, -10, -30},
+    {-30, -30,   0,   0,   0,   0, -30, -30},
+    {-50, -30, -30, -30, -30, -30, -30, -50}
+};
+
+struct TableInit {
+    TableInit() {
+        const int (*tables[6])[8] = {
+            kingMiddleGameTable, queenTable, rookTable, bishopTable, knightTable, pawnTable
+        };
+
+        for (int type = 0; type < 6; ++type) {
+            // The king's value is the same for both sides and is left out
+            PieceType pieceType = static_cast<PieceType>(type);
+            int value = (pieceType == PieceType::King) ? 0 : Piece::pieceValue(pieceType);
+            const int (*endgameTable)[8] =
+                (pieceType == PieceType::King) ? kingEndGameTable : tables[type];
+
+            for (int sq = 0; sq < 64; ++sq) {
+                int row = sq / 8;
+                int col = sq % 8;
+                midgame[0][type][sq] = value + tables[type][row][col];
+                endgame[0][type][sq] = value + endgameTable[row][col];
+                midgame[1][type][sq] = value + tables[type][7 - row][col];
+                endgame[1][type][sq] = value + endgameTable[7 - row][col];
+            }
+        }
+    }
+};
+
+const TableInit tableInit;
+
+} // namespace
+
+} // namespace PieceSquare
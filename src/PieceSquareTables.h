@@ -0,0 +1,16 @@
+#pragma once
+
+// Static evaluation terms that Board sums up incrementally as pieces move:
+// piece value plus a piece-square bonus, once for the middlegame and once
+// for the endgame, and each piece's share of the game phase.
+namespace PieceSquare {
+
+extern int midgame[2][6][64];  // [color][piece type][square]
+extern int endgame[2][6][64];
+
+// Phase weight by piece type (King, Queen, Rook, Bishop, Knight, Pawn).
+// All pieces on the board add up to MaxPhase; bare kings and pawns to 0.
+constexpr int phaseWeight[6] = {0, 4, 2, 1, 1, 0};
+constexpr int MaxPhase = 24;
+
+} // namespace PieceSquare
@@ -6,6 +6,5 @@ class Bishop : public Piece {
 public:
     Bishop(Color c, int r, int col);
 
-    std::vector<Move> getPseudoLegalMoves(const Board& board) const override;
-    Piece* clone() const override;
+    void getPseudoLegalMoves(const Board& board, MoveList& moves) const override;
 };
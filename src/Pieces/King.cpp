@@ -1,12 +1,11 @@
 #include "King.h"
 #include "../Board.h"
 #include "../Move.h"
+#include "../MoveList.h"
 
 King::King(Color c, int r, int col) : Piece(PieceType::King, c, r, col) {}
 
-std::vector<Move> King::getPseudoLegalMoves(const Board& board) const {
-    std::vector<Move> moves;
-
+void King::getPseudoLegalMoves(const Board& board, MoveList& moves) const {
     // Normal king moves (one square in any direction)
     for (int dr = -1; dr <= 1; ++dr) {
         for (int dc = -1; dc <= 1; ++dc) {
@@ -25,14 +24,13 @@ std::vector<Move> King::getPseudoLegalMoves(const Board& board) const {
         }
     }
 
-    // Castling
-    if (!hasMoved) {
-        int homeRow = (color == Color::White) ? 7 : 0;
-
+    // Castling (rights are cleared as soon as the king or rook moves)
+    int homeRow = (color == Color::White) ? 7 : 0;
+    if (row == homeRow && col == 4) {
         // Kingside castling
         if (board.canCastleKingside(color)) {
-            Piece* rook = board.getPiece(homeRow, 7);
-            if (rook && rook->getType() == PieceType::Rook && !rook->getHasMoved()) {
+            const Piece* rook = board.getPiece(homeRow, 7);
+            if (rook && rook->getType() == PieceType::Rook && rook->getColor() == color) {
                 // Check if squares between are empty
                 if (board.isEmpty(homeRow, 5) && board.isEmpty(homeRow, 6)) {
                     moves.push_back(Move(row, col, homeRow, 6, MoveType::CastleKingside));
@@ -42,8 +40,8 @@ std::vector<Move> King::getPseudoLegalMoves(const Board& board) const {
 
         // Queenside castling
         if (board.canCastleQueenside(color)) {
-            Piece* rook = board.getPiece(homeRow, 0);
-            if (rook && rook->getType() == PieceType::Rook && !rook->getHasMoved()) {
+            const Piece* rook = board.getPiece(homeRow, 0);
+            if (rook && rook->getType() == PieceType::Rook && rook->getColor() == color) {
                 // Check if squares between are empty
                 if (board.isEmpty(homeRow, 1) && board.isEmpty(homeRow, 2) && board.isEmpty(homeRow, 3)) {
                     moves.push_back(Move(row, col, homeRow, 2, MoveType::CastleQueenside));
@@ -51,12 +49,4 @@ std::vector<Move> King::getPseudoLegalMoves(const Board& board) const {
             }
         }
     }
-
-    return moves;
-}
-
-Piece* King::clone() const {
-    King* copy = new King(color, row, col);
-    copy->hasMoved = hasMoved;
-    return copy;
 }
@@ -1,12 +1,11 @@
 #include "Knight.h"
 #include "../Board.h"
 #include "../Move.h"
+#include "../MoveList.h"
 
 Knight::Knight(Color c, int r, int col) : Piece(PieceType::Knight, c, r, col) {}
 
-std::vector<Move> Knight::getPseudoLegalMoves(const Board& board) const {
-    std::vector<Move> moves;
-
+void Knight::getPseudoLegalMoves(const Board& board, MoveList& moves) const {
     // L-shaped moves
     int offsets[8][2] = {
         {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
@@ -25,12 +24,4 @@ std::vector<Move> Knight::getPseudoLegalMoves(const Board& board) const {
             moves.push_back(Move(row, col, newRow, newCol, MoveType::Capture));
         }
     }
-
-    return moves;
-}
-
-Piece* Knight::clone() const {
-    Knight* copy = new Knight(color, row, col);
-    copy->hasMoved = hasMoved;
-    return copy;
 }
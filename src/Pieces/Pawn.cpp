@@ -1,12 +1,11 @@
 #include "Pawn.h"
 #include "../Board.h"
 #include "../Move.h"
+#include "../MoveList.h"
 
 Pawn::Pawn(Color c, int r, int col) : Piece(PieceType::Pawn, c, r, col) {}
 
-std::vector<Move> Pawn::getPseudoLegalMoves(const Board& board) const {
-    std::vector<Move> moves;
-
+void Pawn::getPseudoLegalMoves(const Board& board, MoveList& moves) const {
     int direction = (color == Color::White) ? -1 : 1;  // White moves up, black moves down
     int startRow = (color == Color::White) ? 6 : 1;
     int promotionRow = (color == Color::White) ? 0 : 7;
@@ -47,33 +46,14 @@ std::vector<Move> Pawn::getPseudoLegalMoves(const Board& board) const {
             moves.push_back(Move(row, col, newRow, newCol, MoveType::EnPassant));
         }
     }
-
-    return moves;
 }
 
-void Pawn::addPromotionMoves(std::vector<Move>& moves, int fromRow, int fromCol,
+void Pawn::addPromotionMoves(MoveList& moves, int fromRow, int fromCol,
                               int toRow, int toCol, bool isCapture) const {
     MoveType type = isCapture ? MoveType::PromotionCapture : MoveType::Promotion;
 
-    Move queenPromo(fromRow, fromCol, toRow, toCol, type);
-    queenPromo.promotionPiece = PieceType::Queen;
-    moves.push_back(queenPromo);
-
-    Move rookPromo(fromRow, fromCol, toRow, toCol, type);
-    rookPromo.promotionPiece = PieceType::Rook;
-    moves.push_back(rookPromo);
-
-    Move bishopPromo(fromRow, fromCol, toRow, toCol, type);
-    bishopPromo.promotionPiece = PieceType::Bishop;
-    moves.push_back(bishopPromo);
-
-    Move knightPromo(fromRow, fromCol, toRow, toCol, type);
-    knightPromo.promotionPiece = PieceType::Knight;
-    moves.push_back(knightPromo);
-}
-
-Piece* Pawn::clone() const {
-    Pawn* copy = new Pawn(color, row, col);
-    copy->hasMoved = hasMoved;
-    return copy;
+    moves.push_back(Move(fromRow, fromCol, toRow, toCol, type, PieceType::Queen));
+    moves.push_back(Move(fromRow, fromCol, toRow, toCol, type, PieceType::Rook));
+    moves.push_back(Move(fromRow, fromCol, toRow, toCol, type, PieceType::Bishop));
+    moves.push_back(Move(fromRow, fromCol, toRow, toCol, type, PieceType::Knight));
 }
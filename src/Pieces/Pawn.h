@@ -6,10 +6,9 @@ class Pawn : public Piece {
 public:
     Pawn(Color c, int r, int col);
 
-    std::vector<Move> getPseudoLegalMoves(const Board& board) const override;
-    Piece* clone() const override;
+    void getPseudoLegalMoves(const Board& board, MoveList& moves) const override;
 
 private:
-    void addPromotionMoves(std::vector<Move>& moves, int fromRow, int fromCol,
+    void addPromotionMoves(MoveList& moves, int fromRow, int fromCol,
                            int toRow, int toCol, bool isCapture) const;
 };
@@ -86,7 +86,7 @@ void Renderer::drawBoard() {
 void Renderer::drawPieces(const Board& board) {
     for (int row = 0; row < 8; ++row) {
         for (int col = 0; col < 8; ++col) {
-            Piece* piece = board.getPiece(row, col);
+            const Piece* piece = board.getPiece(row, col);
             if (!piece) continue;
 
             float x = static_cast<float>(boardOffsetX + col * squareSize + squareSize / 2);
@@ -147,10 +147,10 @@ void Renderer::drawSelection(int row, int col) {
     window.draw(highlight);
 }
 
-void Renderer::drawLegalMoves(const std::vector<Move>& moves) {
+void Renderer::drawLegalMoves(const MoveList& moves) {
     for (const auto& move : moves) {
-        float centerX = static_cast<float>(boardOffsetX + move.toCol * squareSize + squareSize / 2);
-        float centerY = static_cast<float>(boardOffsetY + move.toRow * squareSize + squareSize / 2);
+        float centerX = static_cast<float>(boardOffsetX + move.toCol() * squareSize + squareSize / 2);
+        float centerY = static_cast<float>(boardOffsetY + move.toRow() * squareSize + squareSize / 2);
 
         if (move.isCapture()) {
             // Draw a ring for captures
@@ -179,15 +179,15 @@ void Renderer::drawLastMove(const Move& move) {
 
     // Highlight from square
     sf::RectangleShape fromHighlight(sf::Vector2f(static_cast<float>(squareSize), static_cast<float>(squareSize)));
-    fromHighlight.setPosition(sf::Vector2f(static_cast<float>(boardOffsetX + move.fromCol * squareSize),
-                                           static_cast<float>(boardOffsetY + move.fromRow * squareSize)));
+    fromHighlight.setPosition(sf::Vector2f(static_cast<float>(boardOffsetX + move.fromCol() * squareSize),
+                                           static_cast<float>(boardOffsetY + move.fromRow() * squareSize)));
     fromHighlight.setFillColor(lastMoveColor);
     window.draw(fromHighlight);
 
     // Highlight to square
     sf::RectangleShape toHighlight(sf::Vector2f(static_cast<float>(squareSize), static_cast<float>(squareSize)));
-    toHighlight.setPosition(sf::Vector2f(static_cast<float>(boardOffsetX + move.toCol * squareSize),
-                                         static_cast<float>(boardOffsetY + move.toRow * squareSize)));
+    toHighlight.setPosition(sf::Vector2f(static_cast<float>(boardOffsetX + move.toCol() * squareSize),
+                                         static_cast<float>(boardOffsetY + move.toRow() * squareSize)));
     toHighlight.setFillColor(lastMoveColor);
     window.draw(toHighlight);
 }
@@ -263,7 +263,7 @@ void Renderer::drawPromotionDialog(Color color, int col) {
 }
 
 void Renderer::render(const Board& board, int selectedRow, int selectedCol,
-                      const std::vector<Move>& legalMoves, const Move& lastMove) {
+                      const MoveList& legalMoves, const Move& lastMove) {
     drawBoard();
     drawLastMove(lastMove);
     drawCheck(board);
@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include "Board.h"
 #include "Move.h"
+#include "MoveList.h"
 #include <vector>
 #include <string>
 
@@ -35,14 +36,14 @@ public:
     void drawBoard();
     void drawPieces(const Board& board);
     void drawSelection(int row, int col);
-    void drawLegalMoves(const std::vector<Move>& moves);
+    void drawLegalMoves(const MoveList& moves);
     void drawLastMove(const Move& move);
     void drawCheck(const Board& board);
     void drawStatus(const std::string& text);
     void drawPromotionDialog(Color color, int col);
 
     void render(const Board& board, int selectedRow, int selectedCol,
-                const std::vector<Move>& legalMoves, const Move& lastMove);
+                const MoveList& legalMoves, const Move& lastMove);
 
     // Coordinate conversion
     bool getSquareFromMouse(int mouseX, int mouseY, int& row, int& col) const;
@@ -0,0 +1,111 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(size_t megabytes) : mask(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    // Largest power of two bucket count that fits, so the index is a mask
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+    buckets = std::vector<Bucket>(count);
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (Bucket& bucket : buckets) {
+        for (Slot& slot : bucket.slots) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+uint64_t TranspositionTable::pack(Move move, int score, int depth, Bound bound, uint8_t gen) {
+    return static_cast<uint64_t>(move.raw()) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(score)) << 16) |
+           (static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48) |
+           (static_cast<uint64_t>(bound) << 56) |
+           (static_cast<uint64_t>(gen) << 58);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const Bucket& bucket = buckets[key & mask];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+        if ((keyXorData ^ data) != key || data == 0) continue;
+
+        entry.move = Move::fromRaw(static_cast<uint16_t>(data));
+        entry.score = static_cast<int32_t>(static_cast<uint32_t>(data >> 16));
+        entry.depth = slotDepth(data);
+        entry.bound = static_cast<Bound>((data >> 56) & 3);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, Bound bound, int score, Move move) {
+    Bucket& bucket = buckets[key & mask];
+
+    // Reuse the slot of the same position, else evict the least valuable one:
+    // entries from older searches first, then the shallowest
+    Slot* target = &bucket.slots[0];
+    uint64_t targetData = target->data.load(std::memory_order_relaxed);
+    bool samePosition = false;
+    int worst = 1 << 30;
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+        if ((keyXorData ^ data) == key || data == 0) {
+            target = &slot;
+            targetData = data;
+            samePosition = data != 0;
+            break;
+        }
+        int age = (generation - slotGeneration(data)) & 0x3F;
+        int value = slotDepth(data) - 8 * age;
+        if (value < worst) {
+            worst = value;
+            target = &slot;
+            targetData = data;
+        }
+    }
+
+    // Keep the old best move when this result has none
+    if (samePosition && !move.isValid()) {
+        move = Move::fromRaw(static_cast<uint16_t>(targetData));
+    }
+
+    uint64_t data = pack(move, score, depth, bound, generation);
+    target->keyXorData.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    size_t sample = buckets.size() < 250 ? buckets.size() : 250;
+    int used = 0;
+    for (size_t i = 0; i < sample; ++i) {
+        for (const Slot& slot : buckets[i].slots) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (data != 0 && slotGeneration(data) == generation) ++used;
+        }
+    }
+    return sample ? static_cast<int>(used * 1000 / (sample * 4)) : 0;
+}
+
+int TranspositionTable::scoreToTT(int score, int ply) {
+    if (score >= MateBound) return score + ply;
+    if (score <= -MateBound) return score - ply;
+    return score;
+}
+
+int TranspositionTable::scoreFromTT(int score, int ply) {
+    if (score >= MateBound) return score - ply;
+    if (score <= -MateBound) return score + ply;
+    return score;
+}
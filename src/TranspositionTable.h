@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Move.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Search scores at or beyond MateBound are mates. The table stores them
+// relative to the node (mate in n from here) and the search converts back
+// to distance from the root, so an entry stays valid at any ply.
+constexpr int MateScore = 100000;
+constexpr int MateBound = MateScore - 1000;
+
+enum class Bound : uint8_t {
+    None,
+    Upper,  // Score is at most this (all moves failed low)
+    Lower,  // Score is at least this (beta cutoff)
+    Exact
+};
+
+struct TTEntry {
+    Move move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+// Fixed-size hash table of search results keyed by Zobrist key. Entries
+// are grouped in 64-byte buckets of four; a new result replaces the entry
+// for the same position, otherwise the shallowest or oldest one.
+//
+// Search threads share one table without locks. Each slot keeps its key
+// XORed with its data, so a slot torn by two concurrent writes no longer
+// matches either key and is ignored by probe.
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    // Reallocates (and clears) the table
+    void resize(size_t megabytes);
+    void clear();
+
+    // Call once per search so entries from earlier searches age out
+    void newSearch() { generation = (generation + 1) & 0x3F; }
+
+    bool probe(uint64_t key, TTEntry& entry) const;
+    void store(uint64_t key, int depth, Bound bound, int score, Move move);
+
+    // Permille of sampled entries written by the current search
+    int hashfull() const;
+
+    static int scoreToTT(int score, int ply);
+    static int scoreFromTT(int score, int ply);
+
+private:
+    // Packed entry: bits 0-15 move, 16-47 score, 48-55 depth,
+    // 56-57 bound, 58-63 generation
+    struct Slot {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[4];
+    };
+
+    std::vector<Bucket> buckets;
+    uint64_t mask;
+    uint8_t generation;
+
+    static uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t generation);
+    static uint8_t slotGeneration(uint64_t data) { return static_cast<uint8_t>(data >> 58); }
+    static int slotDepth(uint64_t data) { return static_cast<int8_t>((data >> 48) & 0xFF); }
+};
@@ -0,0 +1,55 @@
+#include "Zobrist.h"
+
+namespace Zobrist {
+
+uint64_t pieceSquare[2][6][64];
+uint64_t blackToMove;
+uint64_t castling[16];
+uint64_t enPassantFile[8];
+
+namespace {
+
+// splitmix64 with a fixed seed, so keys are identical on every platform
+uint64_t nextKey(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+struct KeyInit {
+    KeyInit() {
+        uint64_t state = 0x54495441ULL;
+
+        for (auto& color : pieceSquare) {
+            for (auto& type : color) {
+                for (auto& key : type) {
+                    key = nextKey(state);
+                }
+            }
+        }
+        blackToMove = nextKey(state);
+
+        // Combined rights hash as the XOR of the individual rights
+        uint64_t rightKeys[4];
+        for (auto& key : rightKeys) {
+            key = nextKey(state);
+        }
+        for (int mask = 0; mask < 16; ++mask) {
+            castling[mask] = 0;
+            for (int bit = 0; bit < 4; ++bit) {
+                if (mask & (1 << bit)) castling[mask] ^= rightKeys[bit];
+            }
+        }
+
+        for (auto& key : enPassantFile) {
+            key = nextKey(state);
+        }
+    }
+};
+
+const KeyInit keyInit;
+
+} // namespace
+
+} // namespace Zobrist
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+// Random 64-bit keys for hashing positions. A position key is the XOR of
+// the keys of every piece on its square, the side to move, the castling
+// rights and the en passant file; Board updates it incrementally.
+namespace Zobrist {
+
+extern uint64_t pieceSquare[2][6][64];  // [color][piece type][square]
+extern uint64_t blackToMove;
+extern uint64_t castling[16];           // Indexed by the castling rights mask
+extern uint64_t enPassantFile[8];
+
+} // namespace Zobrist
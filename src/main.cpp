@@ -1,17 +1,28 @@
 #include "Game.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-int main() {
+// Options: --threads <n> (AI search threads), --verbose (search statistics)
+int main(int argc, char* argv[]) {
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
 #endif
 
     try {
         Game game;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                game.setAIThreads(std::max(1, std::atoi(argv[++i])));
+            } else if (std::strcmp(argv[i], "--verbose") == 0) {
+                game.setVerbose(true);
+            }
+        }
         game.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,118 @@
+#include "../Perft.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --fen <FEN>     Position to count (default: initial position)\n"
+        "  --depth <n>     Search depth (default: 5)\n"
+        "  --threads <n>   Split the root moves across n threads (default: 1)\n"
+        "  --hash <MB>     Memoize subtree counts in a table of this size (default: 0, off)\n"
+        "  --suite         Run the reference positions and check the expected counts\n",
+        program);
+}
+
+bool runSuite(int maxDepth, int threads, size_t hashMB) {
+    bool allPassed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    for (const PerftPosition& position : Perft::referencePositions()) {
+        Board board;
+        board.loadFEN(position.fen);
+
+        // Each position runs to the deepest listed count within maxDepth
+        int depth = std::min(maxDepth, 6);
+        while (depth > 1 && position.expected[depth] == 0) {
+            --depth;
+        }
+
+        // A fresh table per position keeps the runs independent
+        Perft perft(threads, hashMB);
+        PerftResult result = perft.run(board, depth);
+        bool passed = result.nodes == position.expected[depth];
+        allPassed = allPassed && passed;
+        totalNodes += result.nodes;
+        totalSeconds += result.seconds;
+
+        std::printf("%-18s depth %d  %12llu  %s  (%.2f s, %.0f nps)\n",
+                    position.name, depth,
+                    static_cast<unsigned long long>(result.nodes),
+                    passed ? "OK" : "FAILED", result.seconds, result.nodesPerSecond());
+        if (!passed) {
+            std::printf("  expected %llu\n", static_cast<unsigned long long>(position.expected[depth]));
+        }
+    }
+
+    std::printf("\nTotal nodes: %llu\nTime: %.2f s\nNodes/second: %.0f\n",
+                static_cast<unsigned long long>(totalNodes), totalSeconds,
+                totalSeconds > 0.0 ? totalNodes / totalSeconds : 0.0);
+    return allPassed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    int depth = 5;
+    int threads = 1;
+    size_t hashMB = 0;
+    bool suite = false;
+    bool depthGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--fen") == 0 && hasValue) {
+            fen = argv[++i];
+        } else if (std::strcmp(arg, "--depth") == 0 && hasValue) {
+            depth = std::atoi(argv[++i]);
+            depthGiven = true;
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--hash") == 0 && hasValue) {
+            hashMB = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--suite") == 0) {
+            suite = true;
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if (suite) {
+        // Depth 5 keeps the default suite run to a few seconds
+        return runSuite(depthGiven ? depth : 5, threads, hashMB) ? 0 : 1;
+    }
+
+    Board board;
+    if (!board.loadFEN(fen)) {
+        std::fprintf(stderr, "Invalid FEN: %s\n", fen.c_str());
+        return 2;
+    }
+
+    Perft perft(threads, hashMB);
+    PerftResult result = perft.run(board, depth);
+
+    // Divide: per-root-move counts, sorted for diffing against other engines
+    std::sort(result.divide.begin(), result.divide.end(),
+              [](const std::pair<Move, uint64_t>& a, const std::pair<Move, uint64_t>& b) {
+                  return a.first.toString() < b.first.toString();
+              });
+    for (const auto& entry : result.divide) {
+        std::printf("%s: %llu\n", entry.first.toString().c_str(),
+                    static_cast<unsigned long long>(entry.second));
+    }
+
+    std::printf("\nNodes: %llu\nTime: %.3f s\nNodes/second: %.0f\n",
+                static_cast<unsigned long long>(result.nodes), result.seconds,
+                result.nodesPerSecond());
+    return 0;
+}
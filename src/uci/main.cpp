@@ -0,0 +1,241 @@
+#include "../AI.h"
+#include "../Board.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// Kept back from the clock for communication delays
+constexpr int MoveOverheadMs = 50;
+
+std::mutex outputMutex;
+
+// Info lines come from the search thread, everything else from the main one
+void send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+// The legal move written in UCI notation (e2e4, e7e8q), or an invalid move
+Move parseMove(const Board& board, const std::string& text) {
+    MoveList moves;
+    board.getLegalMoves(board.getCurrentTurn(), moves);
+    for (const Move& move : moves) {
+        if (move.toString() == text) return move;
+    }
+    return Move();
+}
+
+std::string formatScore(int score) {
+    if (score >= MateBound) {
+        return "mate " + std::to_string((MateScore - score + 1) / 2);
+    }
+    if (score <= -MateBound) {
+        return "mate -" + std::to_string((MateScore + score) / 2);
+    }
+    return "cp " + std::to_string(score);
+}
+
+std::string formatInfo(const SearchStats& stats) {
+    std::ostringstream info;
+    info << "info depth " << stats.depth << " seldepth " << stats.seldepth
+         << " score " << formatScore(stats.score) << " nodes " << stats.nodes
+         << " nps " << stats.nodesPerSecond << " hashfull " << stats.hashfull
+         << " time " << stats.timeMs << " pv";
+    for (const Move& move : stats.pv) {
+        info << ' ' << move.toString();
+    }
+    return info.str();
+}
+
+class UciEngine {
+public:
+    UciEngine() : ai(Color::White, 0), stopRequested(false), infinite(false) {
+        board.loadFEN(StartFEN);
+        // Fixed seed: the same position and limits give the same answer
+        ai.setRandomSeed(0);
+        ai.setIterationCallback([this](const SearchStats& stats) {
+            reportedPV = stats.pv;
+            send(formatInfo(stats));
+        });
+    }
+
+    ~UciEngine() { stopSearch(); }
+
+    // Reads commands from stdin until "quit" or end of input
+    void run() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            std::istringstream input(line);
+            std::string command;
+            input >> command;
+
+            if (command == "uci") {
+                send("id name Titans");
+                send("id author Titans developers");
+                send("option name Hash type spin default 16 min 1 max 4096");
+                send("option name Threads type spin default 1 min 1 max 256");
+                send("uciok");
+            } else if (command == "isready") {
+                send("readyok");
+            } else if (command == "ucinewgame") {
+                stopSearch();
+                ai.clearHash();
+                board.loadFEN(StartFEN);
+            } else if (command == "setoption") {
+                setOption(input);
+            } else if (command == "position") {
+                stopSearch();
+                position(input);
+            } else if (command == "go") {
+                stopSearch();
+                go(input);
+            } else if (command == "stop") {
+                stopSearch();
+            } else if (command == "quit") {
+                break;
+            }
+        }
+    }
+
+private:
+    Board board;
+    AI ai;
+    std::thread searchThread;
+    std::atomic<bool> stopRequested;
+    bool infinite;
+    std::vector<Move> reportedPV;  // PV of the last info line (search thread)
+
+    // setoption name <name> value <value>
+    void setOption(std::istringstream& input) {
+        std::string token, name, value;
+        input >> token >> name >> token >> value;
+        if (value.empty()) return;
+
+        stopSearch();
+        if (name == "Hash") {
+            ai.setHashSize(static_cast<size_t>(std::max(1, std::atoi(value.c_str()))));
+        } else if (name == "Threads") {
+            ai.setThreads(std::max(1, std::atoi(value.c_str())));
+        }
+    }
+
+    // position startpos|fen <FEN> [moves <move>...]
+    void position(std::istringstream& input) {
+        std::string token;
+        input >> token;
+        if (token == "startpos") {
+            board.loadFEN(StartFEN);
+            input >> token;
+        } else if (token == "fen") {
+            std::string fen;
+            while (input >> token && token != "moves") {
+                fen += token + ' ';
+            }
+            if (!board.loadFEN(fen)) {
+                send("info string invalid fen");
+                board.loadFEN(StartFEN);
+                return;
+            }
+        } else {
+            return;
+        }
+
+        if (token != "moves") return;
+        while (input >> token) {
+            Move move = parseMove(board, token);
+            if (!move.isValid()) {
+                send("info string illegal move " + token);
+                return;
+            }
+            board.makeMove(move);
+        }
+    }
+
+    // go [depth n] [nodes n] [movetime ms] [wtime ms btime ms winc ms binc ms
+    //    movestogo n] [infinite]
+    void go(std::istringstream& input) {
+        SearchLimits limits;
+        int time[2] = {0, 0};
+        int increment[2] = {0, 0};
+        int moveTime = 0;
+        int movesToGo = 0;
+        bool clock = false;
+        infinite = false;
+
+        std::string token;
+        while (input >> token) {
+            if (token == "depth") input >> limits.depth;
+            else if (token == "nodes") input >> limits.nodes;
+            else if (token == "movetime") input >> moveTime;
+            else if (token == "wtime") { input >> time[0]; clock = true; }
+            else if (token == "btime") { input >> time[1]; clock = true; }
+            else if (token == "winc") input >> increment[0];
+            else if (token == "binc") input >> increment[1];
+            else if (token == "movestogo") input >> movesToGo;
+            else if (token == "infinite") infinite = true;
+        }
+
+        Color us = board.getCurrentTurn();
+        if (moveTime > 0) {
+            limits.softTimeMs = moveTime / 2;
+            limits.hardTimeMs = std::max(1, moveTime - MoveOverheadMs);
+        } else if (clock) {
+            // An even share of the remaining time plus most of the increment
+            int remaining = time[static_cast<int>(us)];
+            int budget = remaining / (movesToGo > 0 ? movesToGo + 1 : 30) +
+                         increment[static_cast<int>(us)] * 3 / 4;
+            budget = std::max(1, std::min(budget, remaining - MoveOverheadMs));
+            limits.softTimeMs = std::max(1, budget / 2);
+            limits.hardTimeMs = budget;
+        } else if (limits.depth == 0 && limits.nodes == 0) {
+            infinite = true;  // A bare "go" searches until "stop"
+        }
+
+        stopRequested = false;
+        limits.stop = &stopRequested;
+        ai.setColor(us);
+        reportedPV.clear();
+
+        searchThread = std::thread([this, limits]() {
+            Board searchBoard = board;
+            Move best = ai.getBestMove(searchBoard, limits);
+            // Moves tied with the best are picked from at random, so report
+            // the line of the move actually played if it was not the last one
+            const SearchStats& stats = ai.getLastSearchStats();
+            if (best.isValid() && stats.pv != reportedPV) send(formatInfo(stats));
+
+            // In infinite mode the answer waits for "stop"
+            while (infinite && !stopRequested.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            send("bestmove " + (best.isValid() ? best.toString() : std::string("0000")));
+        });
+    }
+
+    void stopSearch() {
+        if (searchThread.joinable()) {
+            stopRequested = true;
+            searchThread.join();
+        }
+    }
+};
+
+} // namespace
+
+int main() {
+    std::ios::sync_with_stdio(false);
+    UciEngine engine;
+    engine.run();
+    return 0;
+}
@@ -9,10 +9,12 @@
 #include "../Board.h"
 #include "../AI.h"
 #include "../Move.h"
+#include "../MoveList.h"
 #include "../Piece.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <sstream>
-#include <vector>
 
 // Global game state
 static Board* g_board = nullptr;
@@ -20,6 +22,83 @@ static AI* g_ai = nullptr;
 static bool g_gameOver = false;
 static std::string g_gameStatus = "playing";
 
+// Binary game state, kept current after every change so JavaScript can read
+// it in place through a typed-array view of WASM memory (getStateView or
+// getStateBuffer) instead of parsing JSON. Moves use the 16-bit Move
+// encoding: from | to << 6 | flags << 12, squares numbered row * 8 + col
+// from a8; 0 means no move.
+struct StateBuffer {
+    uint8_t squares[64];      // 0 empty, else 1 + type + 6 * color (PieceType / Color values)
+    uint8_t currentTurn;      // Color
+    uint8_t flags;            // StateCheck | StateGameOver
+    uint8_t status;           // GameStatusCode
+    uint8_t castlingRights;   // CastlingRight bits
+    int8_t enPassantSquare;   // -1 if none
+    uint8_t reserved[3];
+    uint16_t lastMove;
+    uint16_t moveCount;       // Legal moves of the side to move
+    uint16_t moves[MoveList::Capacity];
+};
+static_assert(offsetof(StateBuffer, lastMove) == 72, "JavaScript relies on this layout");
+static_assert(offsetof(StateBuffer, moves) == 76, "JavaScript relies on this layout");
+
+enum : uint8_t { StateCheck = 1, StateGameOver = 2 };
+enum GameStatusCode : uint8_t { Playing, WhiteWins, BlackWins, Stalemate, Draw };
+
+static StateBuffer g_state;
+
+static void updateStateBuffer() {
+    g_state = StateBuffer();
+    if (!g_board) return;
+
+    for (int sq = 0; sq < 64; ++sq) {
+        PieceType type = g_board->getPieceTypeAt(sq);
+        if (type != PieceType::None) {
+            int color = static_cast<int>(g_board->getPieceColorAt(sq));
+            g_state.squares[sq] = static_cast<uint8_t>(1 + static_cast<int>(type) + 6 * color);
+        }
+    }
+
+    Color turn = g_board->getCurrentTurn();
+    g_state.currentTurn = static_cast<uint8_t>(turn);
+    g_state.flags = (g_board->isInCheck(turn) ? StateCheck : 0) | (g_gameOver ? StateGameOver : 0);
+    if (g_gameStatus == "white_wins") g_state.status = WhiteWins;
+    else if (g_gameStatus == "black_wins") g_state.status = BlackWins;
+    else if (g_gameStatus == "stalemate") g_state.status = Stalemate;
+    else if (g_gameStatus == "draw") g_state.status = Draw;
+    g_state.castlingRights = g_board->getCastlingRights();
+    g_state.enPassantSquare = static_cast<int8_t>(g_board->getEnPassantSquare());
+    g_state.lastMove = g_board->getLastMove().isValid() ? g_board->getLastMove().raw() : 0;
+
+    MoveList moves;
+    g_board->getLegalMoves(turn, moves);
+    g_state.moveCount = static_cast<uint16_t>(moves.size());
+    for (size_t i = 0; i < moves.size(); ++i) {
+        g_state.moves[i] = moves[i].raw();
+    }
+}
+
+// Make a legal move and update the game status
+static void applyMove(const Move& move) {
+    g_board->makeMove(move);
+    // Note: Board::makeMove already calls switchTurn() internally
+
+    // Check game end conditions
+    Color currentPlayer = g_board->getCurrentTurn();
+    if (g_board->isCheckmate(currentPlayer)) {
+        g_gameOver = true;
+        g_gameStatus = (currentPlayer == Color::White) ? "black_wins" : "white_wins";
+    } else if (g_board->isStalemate(currentPlayer)) {
+        g_gameOver = true;
+        g_gameStatus = "stalemate";
+    } else if (g_board->isDraw()) {
+        g_gameOver = true;
+        g_gameStatus = "draw";
+    }
+
+    updateStateBuffer();
+}
+
 // Initialize or reset the game
 void initGame() {
     delete g_board;
@@ -30,6 +109,7 @@ void initGame() {
     g_ai = new AI(Color::Black, 4);
     g_gameOver = false;
     g_gameStatus = "playing";
+    updateStateBuffer();
 }
 
 // Get board state as JSON string
@@ -42,7 +122,7 @@ std::string getBoardState() {
     for (int row = 0; row < 8; row++) {
         json << "[";
         for (int col = 0; col < 8; col++) {
-            Piece* piece = g_board->getPiece(row, col);
+            const Piece* piece = g_board->getPiece(row, col);
             if (piece) {
                 json << "{\"type\":" << static_cast<int>(piece->getType())
                      << ",\"color\":" << static_cast<int>(piece->getColor()) << "}";
@@ -68,21 +148,21 @@ std::string getBoardState() {
 std::string getLegalMoves(int row, int col) {
     if (!g_board) return "[]";
 
-    Piece* piece = g_board->getPiece(row, col);
+    const Piece* piece = g_board->getPiece(row, col);
     if (!piece || piece->getColor() != g_board->getCurrentTurn()) {
         return "[]";
     }
 
-    std::vector<Move> moves = g_board->getLegalMovesForPiece(row, col);
+    MoveList moves = g_board->getLegalMovesForPiece(row, col);
 
     std::ostringstream json;
     json << "[";
 
     for (size_t i = 0; i < moves.size(); i++) {
         const Move& m = moves[i];
-        json << "{\"toRow\":" << m.toRow
-             << ",\"toCol\":" << m.toCol
-             << ",\"type\":" << static_cast<int>(m.type)
+        json << "{\"toRow\":" << m.toRow()
+             << ",\"toCol\":" << m.toCol()
+             << ",\"type\":" << static_cast<int>(m.type())
              << ",\"isCapture\":" << (m.isCapture() ? "true" : "false")
              << ",\"isPromotion\":" << (m.isPromotion() ? "true" : "false")
              << ",\"isCastle\":" << (m.isCastle() ? "true" : "false")
@@ -98,40 +178,25 @@ std::string getLegalMoves(int row, int col) {
 bool makeMove(int fromRow, int fromCol, int toRow, int toCol, int promotionPiece) {
     if (!g_board || g_gameOver) return false;
 
-    Piece* piece = g_board->getPiece(fromRow, fromCol);
+    const Piece* piece = g_board->getPiece(fromRow, fromCol);
     if (!piece || piece->getColor() != g_board->getCurrentTurn()) {
         return false;
     }
 
     // Find matching legal move
-    std::vector<Move> legalMoves = g_board->getLegalMovesForPiece(fromRow, fromCol);
+    MoveList legalMoves = g_board->getLegalMovesForPiece(fromRow, fromCol);
 
     for (const Move& m : legalMoves) {
-        if (m.toRow == toRow && m.toCol == toCol) {
+        if (m.toRow() == toRow && m.toCol() == toCol) {
             // Found matching move
             Move moveToMake = m;
 
             // Handle promotion
             if (m.isPromotion() && promotionPiece >= 0) {
-                moveToMake.promotionPiece = static_cast<PieceType>(promotionPiece);
-            }
-
-            g_board->makeMove(moveToMake);
-            // Note: Board::makeMove already calls switchTurn() internally
-
-            // Check game end conditions
-            Color currentPlayer = g_board->getCurrentTurn();
-            if (g_board->isCheckmate(currentPlayer)) {
-                g_gameOver = true;
-                g_gameStatus = (currentPlayer == Color::White) ? "black_wins" : "white_wins";
-            } else if (g_board->isStalemate(currentPlayer)) {
-                g_gameOver = true;
-                g_gameStatus = "stalemate";
-            } else if (g_board->isDraw()) {
-                g_gameOver = true;
-                g_gameStatus = "draw";
+                moveToMake.setPromotionPiece(static_cast<PieceType>(promotionPiece));
             }
 
+            applyMove(moveToMake);
             return true;
         }
     }
@@ -148,17 +213,92 @@ std::string getAIMove() {
     if (!bestMove.isValid()) return "{}";
 
     std::ostringstream json;
-    json << "{\"fromRow\":" << bestMove.fromRow
-         << ",\"fromCol\":" << bestMove.fromCol
-         << ",\"toRow\":" << bestMove.toRow
-         << ",\"toCol\":" << bestMove.toCol
-         << ",\"type\":" << static_cast<int>(bestMove.type)
-         << ",\"promotionPiece\":" << static_cast<int>(bestMove.promotionPiece)
+    json << "{\"fromRow\":" << bestMove.fromRow()
+         << ",\"fromCol\":" << bestMove.fromCol()
+         << ",\"toRow\":" << bestMove.toRow()
+         << ",\"toCol\":" << bestMove.toCol()
+         << ",\"type\":" << static_cast<int>(bestMove.type())
+         << ",\"promotionPiece\":" << static_cast<int>(bestMove.promotionPiece())
          << "}";
 
     return json.str();
 }
 
+// Binary interface (see StateBuffer)
+
+// Address of the state buffer in WASM memory, for
+// new Uint8Array(Module.HEAPU8.buffer, getStateBuffer(), getStateBufferSize())
+uintptr_t getStateBuffer() {
+    return reinterpret_cast<uintptr_t>(&g_state);
+}
+
+int getStateBufferSize() {
+    return static_cast<int>(sizeof(StateBuffer));
+}
+
+#ifdef __EMSCRIPTEN__
+// Uint8Array over the state buffer, without copying. Growing memory
+// detaches old views, so fetch a new one rather than keeping it.
+emscripten::val getStateView() {
+    return emscripten::val(emscripten::typed_memory_view(
+        sizeof(StateBuffer), reinterpret_cast<const uint8_t*>(&g_state)));
+}
+#endif
+
+// Make a move given in the 16-bit encoding, returns true if it was legal
+bool makeMoveEncoded(int encoded) {
+    if (!g_board || g_gameOver) return false;
+
+    Move move = Move::fromRaw(static_cast<uint16_t>(encoded));
+    if (!g_board->isLegalMove(g_board->getCurrentTurn(), move)) return false;
+
+    applyMove(move);
+    return true;
+}
+
+// AI's best move in the 16-bit encoding (0 if none); does not make it
+int getAIMoveEncoded() {
+    if (!g_board || !g_ai || g_gameOver) return 0;
+
+    Move bestMove = g_ai->getBestMove(*g_board);
+    return bestMove.isValid() ? bestMove.raw() : 0;
+}
+
+// Get statistics of the last AI search as JSON
+std::string getSearchStats() {
+    if (!g_ai) return "{}";
+
+    const SearchStats& stats = g_ai->getLastSearchStats();
+    std::ostringstream json;
+    json << "{\"nodes\":" << stats.nodes
+         << ",\"qnodes\":" << stats.qnodes
+         << ",\"nps\":" << stats.nodesPerSecond
+         << ",\"depth\":" << stats.depth
+         << ",\"seldepth\":" << stats.seldepth
+         << ",\"score\":" << stats.score
+         << ",\"timeMs\":" << stats.timeMs
+         << ",\"firstMoveCutoffRate\":" << stats.firstMoveCutoffRate()
+         << ",\"hashHits\":" << stats.hashHits
+         << ",\"hashProbes\":" << stats.hashProbes
+         << ",\"iterations\":[";
+    for (size_t i = 0; i < stats.iterations.size(); ++i) {
+        const IterationStats& iteration = stats.iterations[i];
+        if (i > 0) json << ",";
+        json << "{\"depth\":" << iteration.depth
+             << ",\"score\":" << iteration.score
+             << ",\"nodes\":" << iteration.nodes
+             << ",\"timeMs\":" << iteration.timeMs << "}";
+    }
+    json << "],\"pv\":[";
+    for (size_t i = 0; i < stats.pv.size(); ++i) {
+        if (i > 0) json << ",";
+        json << "\"" << stats.pv[i].toString() << "\"";
+    }
+    json << "]}";
+
+    return json.str();
+}
+
 // Check if game is over
 bool isGameOver() {
     return g_gameOver;
@@ -176,6 +316,37 @@ void setAIDepth(int depth) {
     }
 }
 
+// Set AI time budget per move in milliseconds (0 = fixed depth only).
+// The depth from setAIDepth still caps the search; set it to 0 for none.
+void setAITimeLimit(int ms) {
+    if (g_ai) {
+        g_ai->setTimeLimit(ms);
+    }
+}
+
+// Set the number of AI search threads (1 = single-threaded). Needs a
+// build with pthread support; otherwise the AI stays single-threaded.
+void setAIThreads(int threads) {
+    if (g_ai) {
+        g_ai->setThreads(threads);
+    }
+}
+
+// Let the AI choose among moves within margin centipawns of the best one
+// (0 = only equally good moves)
+void setAIRandomMargin(int centipawns) {
+    if (g_ai) {
+        g_ai->setRandomMargin(centipawns);
+    }
+}
+
+// Seed the AI's move choice so a game can be replayed
+void setAIRandomSeed(unsigned int seed) {
+    if (g_ai) {
+        g_ai->setRandomSeed(seed);
+    }
+}
+
 // Get current turn (0 = White, 1 = Black)
 int getCurrentTurn() {
     if (!g_board) return 0;
@@ -196,10 +367,10 @@ std::string getLastMove() {
     if (!lastMove.isValid()) return "{}";
 
     std::ostringstream json;
-    json << "{\"fromRow\":" << lastMove.fromRow
-         << ",\"fromCol\":" << lastMove.fromCol
-         << ",\"toRow\":" << lastMove.toRow
-         << ",\"toCol\":" << lastMove.toCol
+    json << "{\"fromRow\":" << lastMove.fromRow()
+         << ",\"fromCol\":" << lastMove.fromCol()
+         << ",\"toRow\":" << lastMove.toRow()
+         << ",\"toCol\":" << lastMove.toCol()
          << "}";
 
     return json.str();
@@ -211,6 +382,7 @@ void cleanup() {
     delete g_ai;
     g_board = nullptr;
     g_ai = nullptr;
+    updateStateBuffer();
 }
 
 #ifdef __EMSCRIPTEN__
@@ -220,9 +392,19 @@ EMSCRIPTEN_BINDINGS(chess_module) {
     emscripten::function("getLegalMoves", &getLegalMoves);
     emscripten::function("makeMove", &makeMove);
     emscripten::function("getAIMove", &getAIMove);
+    emscripten::function("getSearchStats", &getSearchStats);
+    emscripten::function("getStateBuffer", &getStateBuffer);
+    emscripten::function("getStateBufferSize", &getStateBufferSize);
+    emscripten::function("getStateView", &getStateView);
+    emscripten::function("makeMoveEncoded", &makeMoveEncoded);
+    emscripten::function("getAIMoveEncoded", &getAIMoveEncoded);
     emscripten::function("isGameOver", &isGameOver);
     emscripten::function("getGameStatus", &getGameStatus);
     emscripten::function("setAIDepth", &setAIDepth);
+    emscripten::function("setAITimeLimit", &setAITimeLimit);
+    emscripten::function("setAIThreads", &setAIThreads);
+    emscripten::function("setAIRandomMargin", &setAIRandomMargin);
+    emscripten::function("setAIRandomSeed", &setAIRandomSeed);
     emscripten::function("getCurrentTurn", &getCurrentTurn);
     emscripten::function("isSquareAttacked", &isSquareAttacked);
     emscripten::function("getLastMove", &getLastMove);
@@ -0,0 +1,33 @@
+// Runs the chess engine in a dedicated Web Worker so searches never block
+// the page. Start it as a module worker:
+//
+//   const engine = new Worker('js/engine-worker.js', { type: 'module' });
+//   engine.postMessage({ id: 1, call: 'getAIMove', args: [] });
+//   engine.onmessage = ({ data }) => { /* { id: 1, result } or { id: 1, error } */ };
+//
+// `call` is any function exported by src/wasm/ChessEngine.cpp. Requests are
+// answered in order. On a cross-origin isolated page the multithreaded
+// module is loaded, otherwise the single-threaded one.
+//
+// The modules are loaded from web/wasm/, where the build copies them. To
+// load them from elsewhere, pass the directory in the worker URL:
+//
+//   new Worker('js/engine-worker.js?engine=/static/engine/', { type: 'module' });
+
+const variant = self.crossOriginIsolated ? 'chess-mt' : 'chess-worker';
+const engineDir = new URL(self.location.href).searchParams.get('engine') ?? '../wasm/';
+const enginePromise = import(new URL(`${variant}.mjs`, new URL(engineDir, self.location.href)).href)
+    .then((module) => module.default());
+
+self.onmessage = async ({ data }) => {
+    const { id, call, args = [] } = data;
+    try {
+        const engine = await enginePromise;
+        if (typeof engine[call] !== 'function') {
+            throw new Error(`Unknown engine function: ${call}`);
+        }
+        self.postMessage({ id, result: engine[call](...args) });
+    } catch (error) {
+        self.postMessage({ id, error: String(error) });
+    }
+};